@@ -0,0 +1,35 @@
+/* greeks.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the finite-difference check of the fused Greeks.
+ */
+
+#ifndef __IMPL_GREEKS_H_
+#define __IMPL_GREEKS_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Options checked at most (evenly spaced over the dataset) */
+#define BS_GREEKS_CHECKS (64 * 1024)
+
+/* Allowed error: BS_GREEKS_RTOL * |ref| + BS_GREEKS_ATOL */
+#define BS_GREEKS_RTOL 1e-3
+#define BS_GREEKS_ATOL 1e-4
+
+/* Price in double with the exact N(x) */
+double bs_price_double(double sptPrice, double strike, double rate,
+                       double volatility, double otime, bool call);
+
+/* Compare the Greeks of the SoA options of args against central       *
+ * differences of bs_price_double (bump and reprice); prints the worst *
+ * error of each                                                       */
+bool   bs_greeks_check(const args_t* args);
+
+#endif //__IMPL_GREEKS_H_
@@ -0,0 +1,64 @@
+/* ivol.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Check of the implied-volatility solver
+ *
+ *  The prices the solver inverts are optionData.txt's DerivaGem values,
+ *  which the float pricer matches to 1e-4; an implied vol is therefore
+ *  only as good as 1e-4 / vega. Options far out of the money have next
+ *  to no vega (their price hardly depends on the vol at all), so each
+ *  option is allowed BS_IVOL_VTOL plus that much error, with the vega
+ *  taken in double at the true vol. The options whose allowance stays
+ *  below 1e-3 are the ones that really pin their vol down; how many
+ *  there are, and the worst error among them, is printed too.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "ivol.h"
+
+bool bs_ivol_check(const args_t* args, const float* volatility)
+{
+  size_t n       = args->num_stocks;
+  size_t pinned  = 0;
+  double worst   = 0.0;   // Error over the allowed error
+  double pin_err = 0.0;   // Worst error of the pinned options
+
+  for (size_t i = 0; i < n; i++) {
+    double S = args->sptPrice[i], K = args->strike[i], r = args->rate[i];
+    double v = volatility[i], T = args->otime[i];
+
+    double d1   = (log(S / K) + (r + 0.5 * v * v) * T) / (v * sqrt(T));
+    double vega = S * exp(-0.5 * d1 * d1) * sqrt(T) / sqrt(2.0 * M_PI);
+
+    double err = fabs((double)args->output[i] - v);
+    double tol = BS_IVOL_VTOL + BS_IVOL_CHECK_PTOL / vega;
+
+    /* NaN fails too */
+    if (!(err <= tol)) err = INFINITY;
+
+    if (err / tol > worst) worst = err / tol;
+    if (tol <= 1e-3) {
+      pinned++;
+      if (err > pin_err) pin_err = err;
+    }
+  }
+
+  printf("  * Implied vols vs. the dataset's:\n");
+  printf("      - %zu of %zu options pin their vol down to 1e-3 (worst error %.3e)\n",
+         pinned, n, pin_err);
+  printf("      - Worst error: %.2f of the tolerance\n", worst);
+
+  return worst <= 1.0;
+}
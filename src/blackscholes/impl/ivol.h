@@ -0,0 +1,39 @@
+/* ivol.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the implied-volatility solver's parameters and its check.
+ */
+
+#ifndef __IMPL_IVOL_H_
+#define __IMPL_IVOL_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Bracket the root is searched in */
+#define BS_IVOL_MIN 1e-3f
+#define BS_IVOL_MAX 4.0f
+
+/* Converged once the vol moves less than BS_IVOL_VTOL, or the price *
+ * is within BS_IVOL_PTOL (about the float pricer's own error)       */
+#define BS_IVOL_VTOL 1e-6f
+#define BS_IVOL_PTOL 1e-5f
+
+/* Give up after this many iterations (bisection alone needs 22) */
+#define BS_IVOL_MAX_ITERS 32
+
+/* Allowed error: BS_IVOL_VTOL plus what a 1e-4 price error (the    *
+ * pricing check's tolerance) moves the vol by, 1e-4 / vega          */
+#define BS_IVOL_CHECK_PTOL 1e-4
+
+/* Compare the implied vols in args->output against the true ones;     *
+ * prints the worst error and how many options pin their vol down      */
+bool bs_ivol_check(const args_t* args, const float* volatility);
+
+#endif //__IMPL_IVOL_H_
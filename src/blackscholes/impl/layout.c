@@ -0,0 +1,106 @@
+/* layout.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Conversions between option layouts
+ *
+ *  The feed delivers AoS records (optionData_t, 36 bytes, of which the
+ *  pricer needs 21). SoA keeps one array per field, which SIMD loads
+ *  directly; AoSoA keeps blocks of 8 or 16 options with one row per
+ *  field, so a vector load is still contiguous while all fields of an
+ *  option stay within a few cache lines (and one page). Converting is
+ *  a transpose of the records; the driver times it on its own to show
+ *  whether it pays for itself against pricing the records directly.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "layout.h"
+
+bool bs_layout_parse(const char* str, bs_layout_t* layout)
+{
+  if      (strcasecmp(str, "soa"    ) == 0) { *layout = BS_LAYOUT_SOA;     }
+  else if (strcasecmp(str, "aos"    ) == 0) { *layout = BS_LAYOUT_AOS;     }
+  else if (strcasecmp(str, "aosoa8" ) == 0) { *layout = BS_LAYOUT_AOSOA8;  }
+  else if (strcasecmp(str, "aosoa16") == 0) { *layout = BS_LAYOUT_AOSOA16; }
+  else                                      { return false;                }
+
+  return true;
+}
+
+const char* bs_layout_name(bs_layout_t layout)
+{
+  switch (layout) {
+    case BS_LAYOUT_SOA:     return "soa";
+    case BS_LAYOUT_AOS:     return "aos";
+    case BS_LAYOUT_AOSOA8:  return "aosoa8";
+    case BS_LAYOUT_AOSOA16: return "aosoa16";
+    default:                return "unknown";
+  }
+}
+
+void* bs_layout_alloc(bs_layout_t layout, size_t n)
+{
+  size_t bytes;
+
+  if      (layout == BS_LAYOUT_AOSOA8 ) bytes = ((n +  7) /  8) * sizeof(bs_block8_t);
+  else if (layout == BS_LAYOUT_AOSOA16) bytes = ((n + 15) / 16) * sizeof(bs_block16_t);
+  else                                  return NULL;
+
+  return aligned_alloc(64, ((bytes + 63) / 64) * 64);
+}
+
+/* Records into blocks of W, padding the last block */
+#define __AOS_TO_AOSOA(block_t, W) {                                     \
+  block_t* blocks = (block_t*)args->records;                             \
+                                                                         \
+  for (size_t b = 0; b < (n + W - 1) / W; b++) {                         \
+    for (size_t l = 0; l < W; l++) {                                     \
+      size_t i = b * W + l;                                              \
+      bool   v = (i < n);                                                \
+      blocks[b].sptPrice  [l] = v ? feed[i].sptPrice   : 1.0f;           \
+      blocks[b].strike    [l] = v ? feed[i].strike     : 1.0f;           \
+      blocks[b].rate      [l] = v ? feed[i].rate       : 0.0f;           \
+      blocks[b].volatility[l] = v ? feed[i].volatility : 1.0f;           \
+      blocks[b].otime     [l] = v ? feed[i].otime      : 1.0f;           \
+      blocks[b].otype     [l] = v ? feed[i].otype      : 'C';            \
+    }                                                                    \
+  }                                                                      \
+}
+
+void bs_layout_convert(args_t* args, const optionData_t* feed, size_t n)
+{
+  switch (args->layout) {
+    case BS_LAYOUT_SOA:
+      for (size_t i = 0; i < n; i++) {
+        args->sptPrice  [i] = feed[i].sptPrice;
+        args->strike    [i] = feed[i].strike;
+        args->rate      [i] = feed[i].rate;
+        args->volatility[i] = feed[i].volatility;
+        args->otime     [i] = feed[i].otime;
+        args->otype     [i] = feed[i].otype;
+      }
+      break;
+
+    case BS_LAYOUT_AOS:
+      args->records = (void*)feed;
+      break;
+
+    case BS_LAYOUT_AOSOA8:
+      __AOS_TO_AOSOA(bs_block8_t, 8);
+      break;
+
+    case BS_LAYOUT_AOSOA16:
+      __AOS_TO_AOSOA(bs_block16_t, 16);
+      break;
+  }
+}
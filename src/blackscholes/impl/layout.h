@@ -0,0 +1,53 @@
+/* layout.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the option layouts: the AoSoA blocks and the conversions
+ * from the AoS records of the feed.
+ */
+
+#ifndef __IMPL_LAYOUT_H_
+#define __IMPL_LAYOUT_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* AoSoA blocks: W options, one W-wide row per field. The lanes past  *
+ * the last option are padded with a harmless option (S = K = 1, r = 0, *
+ * vol = T = 1, a call), so kernels can always process whole blocks    */
+typedef struct {
+  float sptPrice  [8];
+  float strike    [8];
+  float rate      [8];
+  float volatility[8];
+  float otime     [8];
+  char  otype     [8];
+} bs_block8_t;
+
+typedef struct {
+  float sptPrice  [16];
+  float strike    [16];
+  float rate      [16];
+  float volatility[16];
+  float otime     [16];
+  char  otype     [16];
+} bs_block16_t;
+
+/* "aos", "soa", "aosoa8", "aosoa16"; false when unknown */
+bool        bs_layout_parse(const char* str, bs_layout_t* layout);
+const char* bs_layout_name (bs_layout_t layout);
+
+/* Storage for n options in the layout (NULL for SoA and AoS, which *
+ * use the arrays and the records themselves)                       */
+void*       bs_layout_alloc(bs_layout_t layout, size_t n);
+
+/* Put the n records of the feed into the layout of args: SoA fills *
+ * the arrays, AoSoA fills args->records, AoS only points at them   */
+void        bs_layout_convert(args_t* args, const optionData_t* feed, size_t n);
+
+#endif //__IMPL_LAYOUT_H_
@@ -1,23 +1,151 @@
 /* para.c
  *
- * Author:
- * Date  :
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
  *
- *  Description
+ *  Implementation of parallelized Black-Scholes
+ *
+ *  The option arrays are cut into chunks small enough that a chunk's
+ *  inputs and prices (25 bytes per option) fit in half of the L2, and
+ *  pinned workers (worker i on CPU cpu + i; the calling thread is
+ *  worker 0) claim chunks from a shared atomic counter and price them
+ *  with the SIMD kernel. Claiming chunks rather than fixed ranges keeps
+ *  the threads busy to the end when some of them run slower.
+ *
+ *  bs_parallel_chunks is shared with the other option kernels.
  */
 
+#define _GNU_SOURCE
+
 /* Standard C includes */
 #include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
 
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
 
+/* If we are on Darwin, include the compatibility header */
+#if defined(__APPLE__)
+#include "common/mach_pthread_compatibility.h"
+#endif
+
 /* Include application-specific headers */
 #include "include/types.h"
+#include "vec.h"
+#include "para.h"
+
+size_t bs_chunk_size(size_t bytes_per_option)
+{
+  static size_t l2 = 0;
+
+  if (l2 == 0) {
+    long size = -1;
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    l2 = (size > 0) ? (size_t)size : BS_DEFAULT_L2;
+  }
+
+  /* Whole AoSoA blocks (so whole vectors), and never less than one */
+  size_t chunk = (l2 / 2 / bytes_per_option) & ~(size_t)15;
+  return (chunk > 0) ? chunk : 16;
+}
+
+/* Shared by the workers of one call */
+typedef struct {
+  void      (*fn)(void* ctx, size_t first, size_t last);
+  void*       ctx;
+  size_t      n;
+  size_t      chunk;
+  size_t      next;   // First unclaimed option
+} chunk_queue_t;
+
+typedef struct {
+  chunk_queue_t* queue;
+  int            cpu;
+} chunk_work_t;
+
+static void drain(chunk_queue_t* q)
+{
+  for (;;) {
+    size_t first = __atomic_fetch_add(&q->next, q->chunk, __ATOMIC_RELAXED);
+    if (first >= q->n) break;
+
+    size_t last = (first + q->chunk < q->n) ? first + q->chunk : q->n;
+    q->fn(q->ctx, first, last);
+  }
+}
+
+static void* chunk_worker(void* args)
+{
+  chunk_work_t* w = (chunk_work_t*)args;
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(w->cpu, &cpuset);
+  int __attribute__((unused)) res = pthread_setaffinity_np(pthread_self(),
+                                                sizeof(cpuset), &cpuset);
+  drain(w->queue);
 
-/* Alternative Implementation */
+  return NULL;
+}
+
+int bs_parallel_chunks(size_t n, size_t chunk, int nthreads, int cpu,
+                        void (*fn)(void* ctx, size_t first, size_t last),
+                        void* ctx)
+{
+  /* No idle threads */
+  size_t chunks = (n + chunk - 1) / chunk;
+  if (nthreads < 1) nthreads = 1;
+  if ((size_t)nthreads > chunks) nthreads = chunks > 0 ? (int)chunks : 1;
+
+  chunk_queue_t queue = { fn, ctx, n, chunk, 0 };
+  pthread_t     tid [nthreads];
+  chunk_work_t  work[nthreads];
+
+  for (int t = 1; t < nthreads; t++) {
+    work[t].queue = &queue;
+    work[t].cpu   = cpu + t;
+    int __attribute__((unused)) res = \
+                   pthread_create(&tid[t], NULL, chunk_worker, (void*)&work[t]);
+  }
+
+  /* The calling thread works too */
+  drain(&queue);
+
+  for (int t = 1; t < nthreads; t++) {
+    pthread_join(tid[t], NULL);
+  }
+
+  return nthreads;
+}
+
+static void price_chunk(void* ctx, size_t first, size_t last)
+{
+  bs_price_vec((const args_t*)ctx, first, last);
+}
+
+/* Parallel Implementation */
 void* impl_parallel(void* args)
 {
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* AoS records bring their unused fields along */
+  size_t bytes = (parsed_args->layout == BS_LAYOUT_AOS) ?
+                 sizeof(optionData_t) + sizeof(float) : BS_OPTION_BYTES;
+
+  /* Implied vols read a price and write an iteration count as well */
+  if (parsed_args->ivol != NULL) {
+    bytes += sizeof(float) + sizeof(int);
+  }
+
+  parsed_args->workers = bs_parallel_chunks(parsed_args->num_stocks, bs_chunk_size(bytes),
+                                            parsed_args->nthreads, parsed_args->cpu,
+                                            price_chunk, parsed_args);
+
   return NULL;
 }
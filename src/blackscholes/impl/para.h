@@ -9,7 +9,25 @@
 #ifndef __IMPL_PARA_H_
 #define __IMPL_PARA_H_
 
+/* Standard C includes */
+#include <stddef.h>
+
+/* L2 size assumed when the system does not report one */
+#define BS_DEFAULT_L2 (1024 * 1024)
+
+/* Bytes an option streams through: five inputs, a type, and a price */
+#define BS_OPTION_BYTES (6 * sizeof(float) + sizeof(char))
+
 /* Function declaration */
 void* impl_parallel(void* args);
 
+/* Options per chunk so that a chunk stays within half of the L2 */
+size_t bs_chunk_size(size_t bytes_per_option);
+
+/* Run fn(ctx, first, last) over chunks of [0, n), claimed in turn by *
+ * up to nthreads pinned threads; returns how many ran                */
+int    bs_parallel_chunks(size_t n, size_t chunk, int nthreads, int cpu,
+                          void (*fn)(void* ctx, size_t first, size_t last),
+                          void* ctx);
+
 #endif //__IMPL_PARA_H_
@@ -1,13 +1,32 @@
 /* scalar.c
  *
- * Author:
- * Date  :
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
  *
- *  Description
+ *  Implementation of scalar Black-Scholes
+ *
+ *  European calls and puts without dividends, priced one option at a
+ *  time exactly as PARSEC's blackscholes does it (single precision,
+ *  the same operation order, and the same CNDF): N(x) is the 5-term
+ *  polynomial approximation of Abramowitz and Stegun (26.2.17), whose
+ *  absolute error is below 7.5e-8, well within the 1e-4 tolerance
+ *  against the DerivaGem prices.
+ *
+ *  The Greeks mode prices each option and takes its delta, gamma,
+ *  vega, theta, and rho from the same d1, d2, N(d1), N(d2), N'(d1)
+ *  (a by-product of the CNDF), and discount factor. Vega and rho are
+ *  per unit (not per percent) of volatility and rate; theta is per
+ *  year of calendar time (-dV/dT).
+ *
+ *  The implied-volatility mode runs the pricer backwards: it finds the
+ *  vol that reproduces a given price with a safeguarded Newton-Raphson
+ *  iteration (see bs_implied_vol), reusing the CNDF's N'(d1) as vega.
  */
 
 /* Standard C includes */
 #include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
 
 /* Include common headers */
 #include "common/macros.h"
@@ -15,9 +34,239 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "layout.h"
+#include "ivol.h"
+#include "scalar.h"
+
+/* N(x), and N'(x) on the side */
+static inline float cndf(float x, float* pdf)
+{
+  /* N(x) = 1 - N(-x): evaluate on |x| */
+  bool  sign   = (x < 0.0f);
+  float xInput = sign ? -x : x;
+
+  /* N'(x) */
+  float xNPrimeofX = expf(-0.5f * xInput * xInput) * BS_INV_SQRT_2PI;
+  *pdf = xNPrimeofX;
+
+  float xK2   = 1.0f / (1.0f + 0.2316419f * xInput);
+  float xK2_2 = xK2   * xK2;
+  float xK2_3 = xK2_2 * xK2;
+  float xK2_4 = xK2_3 * xK2;
+  float xK2_5 = xK2_4 * xK2;
+
+  float xLocal_1 = xK2 * 0.319381530f;
+  float xLocal_2 = xK2_2 * (-0.356563782f);
+  xLocal_2 = xLocal_2 + xK2_3 * 1.781477937f;
+  xLocal_2 = xLocal_2 + xK2_4 * (-1.821255978f);
+  xLocal_2 = xLocal_2 + xK2_5 * 1.330274429f;
+  xLocal_1 = xLocal_2 + xLocal_1;
+
+  float OutputX = 1.0f - xLocal_1 * xNPrimeofX;
+
+  return sign ? 1.0f - OutputX : OutputX;
+}
+
+float bs_cndf(float x)
+{
+  float pdf;
+  return cndf(x, &pdf);
+}
+
+float bs_price(float sptPrice, float strike, float rate,
+               float volatility, float otime, char otype)
+{
+  float xSqrtTime  = sqrtf(otime);
+  float xLogTerm   = logf(sptPrice / strike);
+  float xPowerTerm = 0.5f * volatility * volatility;
+
+  float xDen = volatility * xSqrtTime;
+  float xD1  = ((rate + xPowerTerm) * otime + xLogTerm) / xDen;
+  float xD2  = xD1 - xDen;
+
+  float NofXd1 = bs_cndf(xD1);
+  float NofXd2 = bs_cndf(xD2);
+
+  float FutureValueX = strike * expf(-rate * otime);
+
+  if (otype == 'C' || otype == 'c') {
+    return (sptPrice * NofXd1) - (FutureValueX * NofXd2);
+  } else {
+    return (FutureValueX * (1.0f - NofXd2)) - (sptPrice * (1.0f - NofXd1));
+  }
+}
+
+/* The price and its Greeks from one evaluation of d1, d2, N(d1), *
+ * N(d2), N'(d1), and the discount factor                         */
+float bs_price_greeks(float sptPrice, float strike, float rate,
+                      float volatility, float otime, char otype,
+                      float* delta, float* gamma, float* vega,
+                      float* theta, float* rho)
+{
+  float xSqrtTime  = sqrtf(otime);
+  float xLogTerm   = logf(sptPrice / strike);
+  float xPowerTerm = 0.5f * volatility * volatility;
+
+  float xDen = volatility * xSqrtTime;
+  float xD1  = ((rate + xPowerTerm) * otime + xLogTerm) / xDen;
+  float xD2  = xD1 - xDen;
+
+  float NPrimeofXd1, NPrimeofXd2;
+  float NofXd1 = cndf(xD1, &NPrimeofXd1);
+  float NofXd2 = cndf(xD2, &NPrimeofXd2);
+
+  float Discount     = expf(-rate * otime);
+  float FutureValueX = strike * Discount;
+
+  /* Shared by both option types */
+  float SPrime = sptPrice * NPrimeofXd1;
+  *gamma = SPrime / (sptPrice * sptPrice * xDen);
+  *vega  = SPrime * xSqrtTime;
+  float decay = -0.5f * SPrime * volatility / xSqrtTime;
+
+  if (otype == 'C' || otype == 'c') {
+    *delta = NofXd1;
+    *theta = decay - rate * FutureValueX * NofXd2;
+    *rho   = otime * FutureValueX * NofXd2;
+    return (sptPrice * NofXd1) - (FutureValueX * NofXd2);
+  } else {
+    *delta = NofXd1 - 1.0f;
+    *theta = decay + rate * FutureValueX * (1.0f - NofXd2);
+    *rho   = -otime * FutureValueX * (1.0f - NofXd2);
+    return (FutureValueX * (1.0f - NofXd2)) - (sptPrice * (1.0f - NofXd1));
+  }
+}
+
+/* The vol that prices the option at 'price': Newton-Raphson on the *
+ * vol inside a bracket that every iteration narrows, with a         *
+ * bisection step whenever Newton would leave the bracket            */
+float bs_implied_vol(float sptPrice, float strike, float rate, float otime,
+                     char otype, float price, int* iters)
+{
+  /* Everything but d1 and d2 is the same at every vol */
+  float xSqrtTime    = sqrtf(otime);
+  float xDrift       = logf(sptPrice / strike) + rate * otime;
+  float FutureValueX = strike * expf(-rate * otime);
+  float shift        = (otype == 'C' || otype == 'c') ? 0.0f : 1.0f;
+
+  float lo = BS_IVOL_MIN;
+  float hi = BS_IVOL_MAX;
+
+  /* Manaster-Koehler start, from which Newton converges monotonically */
+  float vol = sqrtf(2.0f * fabsf(xDrift) / otime);
+  vol = fminf(fmaxf(vol, lo), hi);
+
+  int n = 0;
+  while (n < BS_IVOL_MAX_ITERS) {
+    n++;
+
+    float xDen = vol * xSqrtTime;
+    float xD1  = xDrift / xDen + 0.5f * xDen;
+    float xD2  = xD1 - xDen;
+
+    float NPrimeofXd1, NPrimeofXd2;
+    float NofXd1 = cndf(xD1, &NPrimeofXd1) - shift;
+    float NofXd2 = cndf(xD2, &NPrimeofXd2) - shift;
+
+    /* Price (puts through N(d) - 1, as in the Greeks) and vega */
+    float f    = (sptPrice * NofXd1) - (FutureValueX * NofXd2) - price;
+    float vega = sptPrice * NPrimeofXd1 * xSqrtTime;
+
+    if (fabsf(f) <= BS_IVOL_PTOL) break;
+
+    /* The price rises with the vol */
+    if (f > 0.0f) hi = vol;
+    else          lo = vol;
+
+    float next = vol - f / vega;
+    if (!(next > lo && next < hi)) {
+      next = 0.5f * (lo + hi);
+    }
+
+    bool done = fabsf(next - vol) <= BS_IVOL_VTOL;
+    vol = next;
+    if (done) break;
+  }
+
+  *iters = n;
+  return vol;
+}
+
+/* Options of the AoSoA blocks of W, one at a time */
+#define __PRICE_AOSOA(block_t, W) {                                      \
+  const block_t* blocks = (const block_t*)parsed_args->records;          \
+                                                                         \
+  for (size_t i = 0; i < num_stocks; i++) {                              \
+    const block_t* b = &blocks[i / W];                                   \
+    size_t         l = i % W;                                            \
+    dest[i] = bs_price(b->sptPrice[l], b->strike[l], b->rate[l],         \
+                       b->volatility[l], b->otime[l], b->otype[l]);      \
+  }                                                                      \
+}
 
 /* Naive Implementation */
 void* impl_scalar(void* args)
 {
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  const float* sptPrice   = parsed_args->sptPrice;
+  const float* strike     = parsed_args->strike;
+  const float* rate       = parsed_args->rate;
+  const float* volatility = parsed_args->volatility;
+  const float* otime      = parsed_args->otime;
+  const char * otype      = parsed_args->otype;
+        float* dest       = parsed_args->output;
+  size_t       num_stocks = parsed_args->num_stocks;
+
+  /* Greeks mode (SoA only) */
+  bs_greeks_t* greeks = parsed_args->greeks;
+  if (greeks != NULL) {
+    for (size_t i = 0; i < num_stocks; i++) {
+      dest[i] = bs_price_greeks(sptPrice[i], strike[i], rate[i],
+                                volatility[i], otime[i], otype[i],
+                                &greeks->delta[i], &greeks->gamma[i], &greeks->vega[i],
+                                &greeks->theta[i], &greeks->rho[i]);
+    }
+    return NULL;
+  }
+
+  /* Implied-volatility mode (SoA only) */
+  bs_ivol_t* ivol = parsed_args->ivol;
+  if (ivol != NULL) {
+    for (size_t i = 0; i < num_stocks; i++) {
+      dest[i] = bs_implied_vol(sptPrice[i], strike[i], rate[i], otime[i], otype[i],
+                               ivol->price[i], &ivol->iters[i]);
+    }
+    return NULL;
+  }
+
+  switch (parsed_args->layout) {
+    case BS_LAYOUT_SOA:
+      for (size_t i = 0; i < num_stocks; i++) {
+        dest[i] = bs_price(sptPrice[i], strike[i], rate[i],
+                           volatility[i], otime[i], otype[i]);
+      }
+      break;
+
+    case BS_LAYOUT_AOS: {
+      const optionData_t* records = (const optionData_t*)parsed_args->records;
+      for (size_t i = 0; i < num_stocks; i++) {
+        dest[i] = bs_price(records[i].sptPrice, records[i].strike, records[i].rate,
+                           records[i].volatility, records[i].otime, records[i].otype);
+      }
+      break;
+    }
+
+    case BS_LAYOUT_AOSOA8:
+      __PRICE_AOSOA(bs_block8_t, 8);
+      break;
+
+    case BS_LAYOUT_AOSOA16:
+      __PRICE_AOSOA(bs_block16_t, 16);
+      break;
+  }
+
   return NULL;
 }
@@ -9,7 +9,28 @@
 #ifndef __IMPL_SCALAR_H_
 #define __IMPL_SCALAR_H_
 
+/* 1 / sqrt(2 pi) */
+#define BS_INV_SQRT_2PI 0.39894228040143270286f
+
 /* Function declaration */
 void* impl_scalar(void* args);
 
+/* Cumulative normal distribution (PARSEC's polynomial approximation) */
+float bs_cndf(float x);
+
+/* Price of one European option; otype is 'C' (call) or 'P' (put) */
+float bs_price(float sptPrice, float strike, float rate,
+               float volatility, float otime, char otype);
+
+/* Same, with its Greeks from the same intermediate values */
+float bs_price_greeks(float sptPrice, float strike, float rate,
+                      float volatility, float otime, char otype,
+                      float* delta, float* gamma, float* vega,
+                      float* theta, float* rho);
+
+/* Volatility at which the option is worth 'price', and the number of *
+ * iterations it took                                                 */
+float bs_implied_vol(float sptPrice, float strike, float rate, float otime,
+                     char otype, float price, int* iters);
+
 #endif //__IMPL_SCALAR_H_
@@ -1,23 +1,470 @@
 /* vec.c
  *
- * Author:
- * Date  :
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
  *
- *  Description
+ *  Implementation of vectorized Black-Scholes
+ *
+ *  Eight options per AVX2 register, straight from the SoA arrays. The
+ *  arithmetic follows the scalar pricer step by step; log and exp come
+ *  from common/vmath.h, the CNDF is the same polynomial evaluated on
+ *  |x| with the reflection N(x) = 1 - N(-x) done by a blend, and calls
+ *  and puts are both priced and blended on otype, so no lane branches.
+ *  The last num_stocks % 8 options go through masked loads and stores.
+ *
+ *  Besides the SoA arrays, the kernel reads AoS records (gathering the
+ *  fields) and AoSoA blocks (whose rows load like SoA), see layout.c.
+ *  The Greeks mode reuses the intermediates of the price as scalar.c
+ *  does, with puts folded into the call formulas through N(d) - 1.
+ *  The implied-volatility mode iterates all eight lanes together, with
+ *  a mask of the lanes still converging: a converged lane keeps its
+ *  vol and count while the others go on (see ivol8).
  */
 
-/* Standard C includes */
+/* Standard C includes  */
 #include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
+#include "common/vmath.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "layout.h"
+#include "ivol.h"
+#include "scalar.h"
+#include "vec.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* N(x), PARSEC's polynomial, for eight x; N'(x) on the side */
+__attribute__((target("avx2,fma")))
+static inline __m256 cndf8(__m256 x, __m256* pdf)
+{
+  const __m256 one  = _mm256_set1_ps(1.0f);
+  const __m256 sign = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ);
+  const __m256 ax   = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+
+  /* N'(|x|) */
+  __m256 npr = _mm256_exp_ps(_mm256_mul_ps(_mm256_set1_ps(-0.5f), _mm256_mul_ps(ax, ax)));
+  npr = _mm256_mul_ps(npr, _mm256_set1_ps(BS_INV_SQRT_2PI));
+  *pdf = npr;
+
+  __m256 k = _mm256_div_ps(one, _mm256_add_ps(one, _mm256_mul_ps(_mm256_set1_ps(0.2316419f), ax)));
+
+  /* k (a1 + k (a2 + k (a3 + k (a4 + k a5)))) */
+  __m256 poly = _mm256_set1_ps(1.330274429f);
+  poly = _mm256_add_ps(_mm256_mul_ps(poly, k), _mm256_set1_ps(-1.821255978f));
+  poly = _mm256_add_ps(_mm256_mul_ps(poly, k), _mm256_set1_ps( 1.781477937f));
+  poly = _mm256_add_ps(_mm256_mul_ps(poly, k), _mm256_set1_ps(-0.356563782f));
+  poly = _mm256_add_ps(_mm256_mul_ps(poly, k), _mm256_set1_ps( 0.319381530f));
+  poly = _mm256_mul_ps(poly, k);
+
+  __m256 n = _mm256_sub_ps(one, _mm256_mul_ps(poly, npr));
+
+  return _mm256_blendv_ps(n, _mm256_sub_ps(one, n), sign);
+}
+
+/* Prices of eight options; lanes of 'call' are all ones for calls */
+__attribute__((target("avx2,fma")))
+static inline __m256 price8(__m256 S, __m256 K, __m256 r, __m256 v, __m256 T,
+                            __m256 call)
+{
+  const __m256 one = _mm256_set1_ps(1.0f);
+
+  __m256 xSqrtTime  = _mm256_sqrt_ps(T);
+  __m256 xLogTerm   = _mm256_log_ps(_mm256_div_ps(S, K));
+  __m256 xPowerTerm = _mm256_mul_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(v, v));
+
+  __m256 xDen = _mm256_mul_ps(v, xSqrtTime);
+  __m256 xD1  = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(r, xPowerTerm), T), xLogTerm);
+  xD1 = _mm256_div_ps(xD1, xDen);
+  __m256 xD2  = _mm256_sub_ps(xD1, xDen);
+
+  __m256 NPrimeofXd1, NPrimeofXd2;
+  __m256 NofXd1 = cndf8(xD1, &NPrimeofXd1);
+  __m256 NofXd2 = cndf8(xD2, &NPrimeofXd2);
+
+  __m256 FutureValueX = _mm256_mul_ps(K, _mm256_exp_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_setzero_ps(), r), T)));
+
+  __m256 c = _mm256_sub_ps(_mm256_mul_ps(S, NofXd1), _mm256_mul_ps(FutureValueX, NofXd2));
+  __m256 p = _mm256_sub_ps(_mm256_mul_ps(FutureValueX, _mm256_sub_ps(one, NofXd2)),
+                           _mm256_mul_ps(S, _mm256_sub_ps(one, NofXd1)));
+
+  return _mm256_blendv_ps(p, c, call);
+}
+
+/* 'C' / 'c' bytes -> all-ones lanes */
+static inline __m256 call_mask8(const char* otype)
+{
+  __m128i t = _mm_loadl_epi64((const __m128i*)otype);
+  t = _mm_or_si128(t, _mm_set1_epi8(0x20));  // lower case
+  t = _mm_cmpeq_epi8(t, _mm_set1_epi8('c'));
+
+  return _mm256_castsi256_ps(_mm256_cvtepi8_epi32(t));
+}
+
+/* Prices of eight options and their Greeks, sharing d1, d2, N(d1), *
+ * N(d2), N'(d1), and the discount factor (see scalar.c)            */
+__attribute__((target("avx2,fma")))
+static inline __m256 greeks8(__m256 S, __m256 K, __m256 r, __m256 v, __m256 T,
+                             __m256 call, __m256 g[5])
+{
+  const __m256 one  = _mm256_set1_ps(1.0f);
+  const __m256 zero = _mm256_setzero_ps();
+
+  __m256 xSqrtTime  = _mm256_sqrt_ps(T);
+  __m256 xLogTerm   = _mm256_log_ps(_mm256_div_ps(S, K));
+  __m256 xPowerTerm = _mm256_mul_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(v, v));
+
+  __m256 xDen = _mm256_mul_ps(v, xSqrtTime);
+  __m256 xD1  = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(r, xPowerTerm), T), xLogTerm);
+  xD1 = _mm256_div_ps(xD1, xDen);
+  __m256 xD2  = _mm256_sub_ps(xD1, xDen);
+
+  __m256 NPrimeofXd1, NPrimeofXd2;
+  __m256 NofXd1 = cndf8(xD1, &NPrimeofXd1);
+  __m256 NofXd2 = cndf8(xD2, &NPrimeofXd2);
+
+  __m256 Discount     = _mm256_exp_ps(_mm256_mul_ps(_mm256_sub_ps(zero, r), T));
+  __m256 FutureValueX = _mm256_mul_ps(K, Discount);
+
+  /* Shared by both option types */
+  __m256 SPrime = _mm256_mul_ps(S, NPrimeofXd1);
+  __m256 gamma  = _mm256_div_ps(SPrime, _mm256_mul_ps(_mm256_mul_ps(S, S), xDen));
+  __m256 vega   = _mm256_mul_ps(SPrime, xSqrtTime);
+  __m256 decay  = _mm256_div_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(-0.5f), SPrime), v),
+                                xSqrtTime);
+
+  /* Calls use N(d), puts N(d) - 1 = -N(-d): in both, the option is *
+   * S Nd1' - K e^-rT Nd2' with Nd' = N(d) - (put ? 1 : 0)          */
+  __m256 shift = _mm256_andnot_ps(call, one);
+  __m256 Nd1   = _mm256_sub_ps(NofXd1, shift);
+  __m256 Nd2   = _mm256_sub_ps(NofXd2, shift);
+  __m256 KNd2  = _mm256_mul_ps(FutureValueX, Nd2);
+
+  g[0] = Nd1;
+  g[1] = gamma;
+  g[2] = vega;
+  g[3] = _mm256_sub_ps(decay, _mm256_mul_ps(r, KNd2));
+  g[4] = _mm256_mul_ps(T, KNd2);
+
+  return _mm256_sub_ps(_mm256_mul_ps(S, Nd1), KNd2);
+}
+
+/* Implied vols of eight options, bs_implied_vol lane by lane: each   *
+ * lane stops (and stops counting) as it converges, the vector once    *
+ * all of its active lanes have                                        */
+__attribute__((target("avx2,fma")))
+static inline __m256 ivol8(__m256 S, __m256 K, __m256 r, __m256 T, __m256 call,
+                           __m256 price, __m256 active, __m256i* iters)
+{
+  const __m256 one  = _mm256_set1_ps(1.0f);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 ptol = _mm256_set1_ps(BS_IVOL_PTOL);
+  const __m256 vtol = _mm256_set1_ps(BS_IVOL_VTOL);
+
+  /* Everything but d1 and d2 is the same at every vol */
+  __m256 xSqrtTime    = _mm256_sqrt_ps(T);
+  __m256 xDrift       = _mm256_add_ps(_mm256_log_ps(_mm256_div_ps(S, K)), _mm256_mul_ps(r, T));
+  __m256 FutureValueX = _mm256_mul_ps(K, _mm256_exp_ps(_mm256_mul_ps(_mm256_sub_ps(zero, r), T)));
+  __m256 shift        = _mm256_andnot_ps(call, one);
+
+  __m256 lo = _mm256_set1_ps(BS_IVOL_MIN);
+  __m256 hi = _mm256_set1_ps(BS_IVOL_MAX);
+
+  /* Manaster-Koehler start */
+  __m256 vol = _mm256_sqrt_ps(_mm256_div_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f),
+                                                          _mm256_andnot_ps(sign, xDrift)), T));
+  vol = _mm256_min_ps(_mm256_max_ps(vol, lo), hi);
+
+  __m256i n = _mm256_setzero_si256();
+
+  for (int it = 0; it < BS_IVOL_MAX_ITERS && _mm256_movemask_ps(active); it++) {
+    n = _mm256_sub_epi32(n, _mm256_castps_si256(active));
+
+    __m256 xDen = _mm256_mul_ps(vol, xSqrtTime);
+    __m256 xD1  = _mm256_add_ps(_mm256_div_ps(xDrift, xDen), _mm256_mul_ps(half, xDen));
+    __m256 xD2  = _mm256_sub_ps(xD1, xDen);
+
+    __m256 NPrimeofXd1, NPrimeofXd2;
+    __m256 NofXd1 = _mm256_sub_ps(cndf8(xD1, &NPrimeofXd1), shift);
+    __m256 NofXd2 = _mm256_sub_ps(cndf8(xD2, &NPrimeofXd2), shift);
+
+    __m256 f    = _mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(S, NofXd1),
+                                              _mm256_mul_ps(FutureValueX, NofXd2)), price);
+    __m256 vega = _mm256_mul_ps(_mm256_mul_ps(S, NPrimeofXd1), xSqrtTime);
+
+    __m256 done = _mm256_cmp_ps(_mm256_andnot_ps(sign, f), ptol, _CMP_LE_OQ);
+    __m256 move = _mm256_andnot_ps(done, active);
+
+    /* Narrow the bracket of the lanes still moving */
+    __m256 above = _mm256_cmp_ps(f, zero, _CMP_GT_OQ);
+    hi = _mm256_blendv_ps(hi, vol, _mm256_and_ps   (move, above));
+    lo = _mm256_blendv_ps(lo, vol, _mm256_andnot_ps(above, move));
+
+    /* Newton, or bisection where Newton leaves the bracket (NaN too) */
+    __m256 next   = _mm256_sub_ps(vol, _mm256_div_ps(f, vega));
+    __m256 inside = _mm256_and_ps(_mm256_cmp_ps(next, lo, _CMP_GT_OQ),
+                                  _mm256_cmp_ps(next, hi, _CMP_LT_OQ));
+    next = _mm256_blendv_ps(_mm256_mul_ps(half, _mm256_add_ps(lo, hi)), next, inside);
+
+    done = _mm256_or_ps(done, _mm256_cmp_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(next, vol)),
+                                            vtol, _CMP_LE_OQ));
+    vol    = _mm256_blendv_ps(vol, next, move);
+    active = _mm256_andnot_ps(done, active);
+  }
+
+  *iters = n;
+  return vol;
+}
+#endif
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Lanes [0, rem) of a vector */
+static inline __m256i lanes8(size_t rem)
+{
+  return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)rem),
+                            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+__attribute__((target("avx2,fma")))
+static void price_soa(const args_t* args, size_t first, size_t last)
+{
+  const float* sptPrice   = args->sptPrice;
+  const float* strike     = args->strike;
+  const float* rate       = args->rate;
+  const float* volatility = args->volatility;
+  const float* otime      = args->otime;
+  const char * otype      = args->otype;
+        float* dest       = args->output;
+
+  size_t i = first;
+  for (; i + 8 <= last; i += 8) {
+    __m256 price = price8(_mm256_loadu_ps(&sptPrice[i]), _mm256_loadu_ps(&strike[i]),
+                          _mm256_loadu_ps(&rate[i]), _mm256_loadu_ps(&volatility[i]),
+                          _mm256_loadu_ps(&otime[i]), call_mask8(&otype[i]));
+    _mm256_storeu_ps(&dest[i], price);
+  }
+
+  /* Tail: masked off lanes read as 0, so give them a harmless option */
+  if (i < last) {
+    size_t  rem  = last - i;
+    __m256i mask = lanes8(rem);
+    __m256  lane = _mm256_castsi256_ps(mask);
+    __m256  one  = _mm256_set1_ps(1.0f);
+
+    char types[8] = { 0 };
+    memcpy(types, &otype[i], rem);
+
+    __m256 price = price8(_mm256_blendv_ps(one, _mm256_maskload_ps(&sptPrice[i]  , mask), lane),
+                          _mm256_blendv_ps(one, _mm256_maskload_ps(&strike[i]    , mask), lane),
+                          _mm256_maskload_ps(&rate[i], mask),
+                          _mm256_blendv_ps(one, _mm256_maskload_ps(&volatility[i], mask), lane),
+                          _mm256_blendv_ps(one, _mm256_maskload_ps(&otime[i]     , mask), lane),
+                          call_mask8(types));
+    _mm256_maskstore_ps(&dest[i], mask, price);
+  }
+}
+
+/* Records: gather each field, 9 words apart (otype is the low byte *
+ * of word 6)                                                       */
+__attribute__((target("avx2,fma")))
+static void price_aos(const args_t* args, size_t first, size_t last)
+{
+  const optionData_t* records = (const optionData_t*)args->records;
+        float*        dest    = args->output;
+
+  const __m256i stride = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                            _mm256_set1_epi32(sizeof(optionData_t) / sizeof(float)));
+  const __m256  one    = _mm256_set1_ps(1.0f);
+  const __m256  zero   = _mm256_setzero_ps();
+
+  for (size_t i = first; i < last; i += 8) {
+    const float* base = (const float*)&records[i];
+    __m256i      mask = lanes8(last - i);
+    __m256       lane = _mm256_castsi256_ps(mask);
+
+    #define __GATHER(field, benign)                                              \
+      _mm256_mask_i32gather_ps(benign, base,                                     \
+        _mm256_add_epi32(stride, _mm256_set1_epi32(offsetof(optionData_t, field) \
+                                                   / sizeof(float))), lane, 4)
+
+    __m256i type = _mm256_mask_i32gather_epi32(_mm256_set1_epi32('C'), (const int*)base,
+                     _mm256_add_epi32(stride, _mm256_set1_epi32(offsetof(optionData_t, otype)
+                                                                / sizeof(float))), mask, 4);
+    type = _mm256_or_si256(_mm256_and_si256(type, _mm256_set1_epi32(0xff)),
+                           _mm256_set1_epi32(0x20));
+    __m256 call = _mm256_castsi256_ps(_mm256_cmpeq_epi32(type, _mm256_set1_epi32('c')));
+
+    __m256 price = price8(__GATHER(sptPrice, one), __GATHER(strike, one),
+                          __GATHER(rate, zero), __GATHER(volatility, one),
+                          __GATHER(otime, one), call);
+
+    #undef __GATHER
+
+    _mm256_maskstore_ps(&dest[i], mask, price);
+  }
+}
+
+/* AoSoA: every vector is one row of a block (padding is priced too, *
+ * but never stored)                                                 */
+#define __PRICE_AOSOA(block_t, W) {                                         \
+  const block_t* blocks = (const block_t*)args->records;                    \
+        float*   dest   = args->output;                                     \
+                                                                            \
+  for (size_t i = first; i < last; i += 8) {                                \
+    const block_t* b = &blocks[i / W];                                      \
+    size_t         l = i % W;                                               \
+    __m256 price = price8(_mm256_loadu_ps(&b->sptPrice[l]),                 \
+                          _mm256_loadu_ps(&b->strike[l]),                   \
+                          _mm256_loadu_ps(&b->rate[l]),                     \
+                          _mm256_loadu_ps(&b->volatility[l]),               \
+                          _mm256_loadu_ps(&b->otime[l]),                    \
+                          call_mask8(&b->otype[l]));                        \
+    if (i + 8 <= last) _mm256_storeu_ps(&dest[i], price);                   \
+    else               _mm256_maskstore_ps(&dest[i], lanes8(last - i), price); \
+  }                                                                         \
+}
+
+__attribute__((target("avx2,fma")))
+static void price_aosoa8(const args_t* args, size_t first, size_t last)
+{
+  __PRICE_AOSOA(bs_block8_t, 8);
+}
+
+__attribute__((target("avx2,fma")))
+static void price_aosoa16(const args_t* args, size_t first, size_t last)
+{
+  __PRICE_AOSOA(bs_block16_t, 16);
+}
+
+/* Greeks mode: SoA in, the price and five arrays of Greeks out */
+__attribute__((target("avx2,fma")))
+static void greeks_soa(const args_t* args, size_t first, size_t last)
+{
+  const float* sptPrice   = args->sptPrice;
+  const float* strike     = args->strike;
+  const float* rate       = args->rate;
+  const float* volatility = args->volatility;
+  const float* otime      = args->otime;
+  const char * otype      = args->otype;
+        float* dest       = args->output;
+        float* out[5]     = { args->greeks->delta, args->greeks->gamma, args->greeks->vega,
+                              args->greeks->theta, args->greeks->rho };
+
+  const __m256 one = _mm256_set1_ps(1.0f);
+
+  for (size_t i = first; i < last; i += 8) {
+    size_t  rem  = last - i;
+    __m256i mask = lanes8(rem);
+    __m256  lane = _mm256_castsi256_ps(mask);
+
+    /* Masked off lanes read as 0, so give them a harmless option */
+    char types[8] = { 0 };
+    memcpy(types, &otype[i], rem < 8 ? rem : 8);
+
+    __m256 g[5];
+    __m256 price = greeks8(_mm256_blendv_ps(one, _mm256_maskload_ps(&sptPrice[i]  , mask), lane),
+                           _mm256_blendv_ps(one, _mm256_maskload_ps(&strike[i]    , mask), lane),
+                           _mm256_maskload_ps(&rate[i], mask),
+                           _mm256_blendv_ps(one, _mm256_maskload_ps(&volatility[i], mask), lane),
+                           _mm256_blendv_ps(one, _mm256_maskload_ps(&otime[i]     , mask), lane),
+                           call_mask8(types), g);
+
+    _mm256_maskstore_ps(&dest[i], mask, price);
+    for (int k = 0; k < 5; k++) _mm256_maskstore_ps(&out[k][i], mask, g[k]);
+  }
+}
+
+/* Implied-volatility mode: SoA options and prices in, vols out */
+__attribute__((target("avx2,fma")))
+static void ivol_soa(const args_t* args, size_t first, size_t last)
+{
+  const float* sptPrice = args->sptPrice;
+  const float* strike   = args->strike;
+  const float* rate     = args->rate;
+  const float* otime    = args->otime;
+  const char * otype    = args->otype;
+  const float* price    = args->ivol->price;
+        int  * iters    = args->ivol->iters;
+        float* dest     = args->output;
+
+  const __m256 one = _mm256_set1_ps(1.0f);
+
+  for (size_t i = first; i < last; i += 8) {
+    size_t  rem  = last - i;
+    __m256i mask = lanes8(rem);
+    __m256  lane = _mm256_castsi256_ps(mask);
+
+    /* Masked off lanes read as 0, so give them a harmless option; *
+     * they start (and stay) inactive                              */
+    char types[8] = { 0 };
+    memcpy(types, &otype[i], rem < 8 ? rem : 8);
+
+    __m256i n;
+    __m256  vol = ivol8(_mm256_blendv_ps(one, _mm256_maskload_ps(&sptPrice[i], mask), lane),
+                        _mm256_blendv_ps(one, _mm256_maskload_ps(&strike[i]  , mask), lane),
+                        _mm256_maskload_ps(&rate[i], mask),
+                        _mm256_blendv_ps(one, _mm256_maskload_ps(&otime[i]   , mask), lane),
+                        call_mask8(types),
+                        _mm256_maskload_ps(&price[i], mask),
+                        lane, &n);
+
+    _mm256_maskstore_ps(&dest[i], mask, vol);
+    _mm256_maskstore_epi32(&iters[i], mask, n);
+  }
+}
+#endif
+
+void bs_price_vec(const args_t* args, size_t first, size_t last)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  if (args->greeks != NULL) {
+    greeks_soa(args, first, last);
+    return;
+  }
+  if (args->ivol != NULL) {
+    ivol_soa(args, first, last);
+    return;
+  }
+
+  switch (args->layout) {
+    case BS_LAYOUT_SOA:     price_soa    (args, first, last); break;
+    case BS_LAYOUT_AOS:     price_aos    (args, first, last); break;
+    case BS_LAYOUT_AOSOA8:  price_aosoa8 (args, first, last); break;
+    case BS_LAYOUT_AOSOA16: price_aosoa16(args, first, last); break;
+  }
+#else
+  for (size_t i = first; i < last && args->ivol != NULL; i++) {
+    args->output[i] = bs_implied_vol(args->sptPrice[i], args->strike[i], args->rate[i],
+                                     args->otime[i], args->otype[i],
+                                     args->ivol->price[i], &args->ivol->iters[i]);
+  }
+  for (size_t i = first; i < last && args->ivol == NULL; i++) {
+    args->output[i] = bs_price(args->sptPrice[i], args->strike[i], args->rate[i],
+                               args->volatility[i], args->otime[i], args->otype[i]);
+  }
+#endif
+}
 
 /* Alternative Implementation */
 void* impl_vector(void* args)
 {
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  bs_price_vec(parsed_args, 0, parsed_args->num_stocks);
+
+  /* Done */
   return NULL;
 }
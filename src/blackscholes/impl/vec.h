@@ -9,7 +9,16 @@
 #ifndef __IMPL_VEC_H_
 #define __IMPL_VEC_H_
 
+/* Standard C includes */
+#include <stddef.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
 /* Function declaration */
 void* impl_vector(void* args);
 
+/* Price options [first, last) of args, eight at a time */
+void  bs_price_vec(const args_t* args, size_t first, size_t last);
+
 #endif //__IMPL_VEC_H_
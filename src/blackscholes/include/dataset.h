@@ -20,22 +20,6 @@
                            (x == 5? "native": \
                                     "unknown" )))))))
 
-/* Struct for the optionData.txt dataset
- * ref: PARSEC v3.0
- */
-typedef struct _optionData_t {
-  float sptPrice;
-  float strike;
-  float rate;
-  float divq;
-  float volatility;
-  float otime;
-
-  char  otype;
-  float divs;
-  float price;
-} optionData_t;
-
 optionData_t refDataSet[] = {
   #include "dataset/optionData.txt"
 };
@@ -69,5 +53,12 @@ void genDataset(args_t* args) {
   }
 }
 
+/* The same options as records, the way the upstream feed delivers them */
+void genRecords(optionData_t* records, size_t num_stocks) {
+  for (size_t i = 0; i < num_stocks; i++) {
+    records[i] = refDataSet[i % REF_DATASET_SIZE];
+  }
+}
+
 #endif //__INCLUDE_DATASET_H_
 
@@ -9,6 +9,51 @@
 #ifndef __INCLUDE_TYPES_H_
 #define __INCLUDE_TYPES_H_
 
+/* Struct for the optionData.txt dataset, also the record of the AoS
+ * layout (it is what the upstream feed delivers)
+ * ref: PARSEC v3.0
+ */
+typedef struct _optionData_t {
+  float sptPrice;
+  float strike;
+  float rate;
+  float divq;
+  float volatility;
+  float otime;
+
+  char  otype;
+  float divs;
+  float price;
+} optionData_t;
+
+/* How the options are stored:
+ *   BS_LAYOUT_SOA     -> one array per field (sptPrice, strike, ...)
+ *   BS_LAYOUT_AOS     -> records: optionData_t[num_stocks]
+ *   BS_LAYOUT_AOSOA8  -> records: blocks of 8 options, field by field
+ *   BS_LAYOUT_AOSOA16 -> records: blocks of 16 options, field by field
+ */
+typedef enum {
+  BS_LAYOUT_SOA,
+  BS_LAYOUT_AOS,
+  BS_LAYOUT_AOSOA8,
+  BS_LAYOUT_AOSOA16
+} bs_layout_t;
+
+/* Greeks of every option (per unit of vol and rate, theta per year) */
+typedef struct {
+  float* delta;
+  float* gamma;
+  float* vega ;
+  float* theta;
+  float* rho  ;
+} bs_greeks_t;
+
+/* Implied volatility: the prices to invert, and the work each took */
+typedef struct {
+  const float* price;   // Market prices (optionData.txt's reference values)
+  int*         iters;   // Iterations each option took
+} bs_ivol_t;
+
 typedef struct {
   size_t num_stocks;
 
@@ -20,8 +65,17 @@ typedef struct {
   char * otype     ;
   float* output    ;
 
+  bs_layout_t layout ;
+  void*       records;  // AoS or AoSoA options; the arrays above are SoA
+
+  bs_greeks_t* greeks;  // When set (SoA only), the Greeks are computed too
+  bs_ivol_t*   ivol;    // When set (SoA only), output gets the volatilities
+                        // that reproduce ivol->price instead of prices
+
   int    cpu;
   int    nthreads;
+  int    workers;   // Threads impl_parallel ran (fewer than nthreads
+                    // when there are fewer chunks)
 } args_t;
 
 #endif //__INCLUDE_TYPES_H_
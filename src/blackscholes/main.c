@@ -46,6 +46,9 @@
 #include "impl/scalar.h"
 #include "impl/vec.h"
 #include "impl/para.h"
+#include "impl/layout.h"
+#include "impl/greeks.h"
+#include "impl/ivol.h"
 
 /* Include common headers */
 #include "common/types.h"
@@ -73,6 +76,16 @@ int main(int argc, char** argv)
   int dataset      = 0;
   int dataset_size = 0;
 
+  /* Layout (the SoA arrays of genDataset, unless one is asked for) */
+  bs_layout_t layout     = BS_LAYOUT_SOA;
+  bool        layout_set = false;
+
+  /* Greeks alongside the price */
+  bool        greeks_on  = false;
+
+  /* Implied volatility instead of prices */
+  bool        ivol_on    = false;
+
   /* Parse arguments */
   /* Function pointers */
   void* (*impl_scalar_ptr  )(void* args) = impl_scalar;
@@ -130,6 +143,35 @@ int main(int argc, char** argv)
       continue;
     }
 
+    /* Choosing a layout */
+    if (strcmp(argv[i], "--layout") == 0) {
+      assert (++i < argc);
+      if (!bs_layout_parse(argv[i], &layout)) {
+        printf("\n");
+        printf("ERROR: Unknown layout \"%s\"\n", argv[i]);
+
+        parse_args_err = true;
+        break;
+      }
+      layout_set = true;
+
+      continue;
+    }
+
+    /* Greeks */
+    if (strcmp(argv[i], "--greeks") == 0) {
+      greeks_on = true;
+
+      continue;
+    }
+
+    /* Implied volatility */
+    if (strcmp(argv[i], "--implied-vol") == 0) {
+      ivol_on = true;
+
+      continue;
+    }
+
     /* Run parameterization */
     if (strcmp(argv[i], "--nruns") == 0) {
       assert (++i < argc);
@@ -173,6 +215,20 @@ int main(int argc, char** argv)
     printf("ERROR: No implementation was chosen.\n");
   }
 
+  if (greeks_on && layout_set && layout != BS_LAYOUT_SOA) {
+    printf("\n");
+    printf("ERROR: --greeks supports the soa layout only.\n");
+
+    parse_args_err = true;
+  }
+
+  if (ivol_on && (greeks_on || (layout_set && layout != BS_LAYOUT_SOA))) {
+    printf("\n");
+    printf("ERROR: --implied-vol supports the soa layout only, without --greeks.\n");
+
+    parse_args_err = true;
+  }
+
   if (help || impl == NULL || parse_args_err) {
     printf("\n");
     printf("Usage:\n");
@@ -187,6 +243,12 @@ int main(int argc, char** argv)
     printf("    -c | --cpu       Set the main CPU for the program (default = %d)\n", cpu);
     printf("    -d | --dataset   Dataset to be used (default = %s)\n", __dataset_name(dataset));
     printf("                     Available datasets = {test, dev, small, medium, large, native}.\n");
+    printf("         --layout    Convert AoS records to = {aos, soa, aosoa8, aosoa16} (timed\n");
+    printf("                     separately) and price them in that layout (default = soa arrays)\n");
+    printf("         --greeks    Also compute delta, gamma, vega, theta, and rho in the same pass\n");
+    printf("         --implied-vol\n");
+    printf("                     Recover the volatilities from the reference prices (Newton-\n");
+    printf("                     Raphson, bisection safeguard) instead of pricing\n");
     printf("         --nruns     Number of runs to the implementation (default = %d)\n", nruns);
     printf("         --stdevs    Number of standard deviation to exclude outliers (default = %d)\n", nstdevs);
     printf("\n");
@@ -303,9 +365,14 @@ int main(int argc, char** argv)
   args_ref.otime      = otime       ;
   args_ref.otype      = otype       ;
   args_ref.output     = ref         ;
+  args_ref.layout     = BS_LAYOUT_SOA;
+  args_ref.records    = NULL        ;
+  args_ref.greeks     = NULL        ;
+  args_ref.ivol       = NULL        ;
 
   args_ref.cpu        = cpu         ;
   args_ref.nthreads   = nthreads    ;
+  args_ref.workers    = nthreads    ;
 
   /* Call genDataset to generate dataset and reference output */
   printf("  * Invoking genDataset .... ");
@@ -326,9 +393,65 @@ int main(int argc, char** argv)
   args.otime      = otime       ;
   args.otype      = otype       ;
   args.output     = dest        ;
+  args.layout     = BS_LAYOUT_SOA;
+  args.records    = NULL        ;
+  args.greeks     = NULL        ;
+  args.ivol       = NULL        ;
+
+  /* Greeks: five more outputs, guarded like the prices */
+  bs_greeks_t greeks;
+  if (greeks_on) {
+    float** arrays[5] = { &greeks.delta, &greeks.gamma, &greeks.vega,
+                          &greeks.theta, &greeks.rho };
+    for (int g = 0; g < 5; g++) {
+      *arrays[g] = __ALLOC_DATA(float, dataset_size + 1);
+      __SET_GUARD(*arrays[g], dataset_size * sizeof(float));
+    }
+    args.greeks = &greeks;
+  }
+
+  /* Implied vols: invert the reference prices into dest; the kernels
+     never see the true vols, which only the check reads */
+  bs_ivol_t ivol;
+  int*      iters = NULL;
+  if (ivol_on) {
+    iters = __ALLOC_DATA(int, dataset_size + 1);
+    __SET_GUARD(iters, dataset_size * sizeof(int));
+
+    ivol.price      = ref;
+    ivol.iters      = iters;
+    args.ivol       = &ivol;
+    args.volatility = NULL;
+  }
 
   args.cpu        = cpu         ;
   args.nthreads   = nthreads    ;
+  args.workers    = nthreads    ;
+
+  /* Layout: the feed delivers AoS records, converted here (and timed
+     on its own) into the layout the kernel reads */
+  optionData_t* feed        = NULL;
+  uint64_t      convert_avg = 0;
+  if (layout_set) {
+    feed = __ALLOC_DATA(optionData_t, dataset_size + 0);
+    genRecords(feed, dataset_size);
+
+    args.layout  = layout;
+    args.records = bs_layout_alloc(layout, dataset_size);
+
+    printf("Converting AoS records to \"%s\" %d times .... ", bs_layout_name(layout), num_runs);
+    for (int i = 0; i < num_runs; i++) {
+      __SET_START_TIME();
+      bs_layout_convert(&args, feed, dataset_size);
+      __SET_END_TIME();
+      convert_avg += __CALC_RUNTIME();
+    }
+    convert_avg /= num_runs;
+    printf("Finished\n");
+    printf("  * Conversion: %" PRIu64 " ns (%.2f ns per option)\n",
+           convert_avg, (double)convert_avg / dataset_size);
+    printf("\n");
+  }
 
   /* Start execution */
   printf("Running \"%s\" implementation:\n", impl_str);
@@ -345,10 +468,27 @@ int main(int argc, char** argv)
   printf("Finished\n");
 
   /* Verfication */
+  /* The Greeks are checked first; the verdict below covers them too */
+  bool greeks_match = !greeks_on || bs_greeks_check(&args);
+
+  /* Implied vols are checked against the dataset's vols, not prices */
+  bool ivol_match   = ivol_on && bs_ivol_check(&args, volatility);
+
   printf("  * Verifying results .... ");
 
-  bool match = __CHECK_FLOAT_MATCH(ref, dest, dataset_size, 1e-4);
+  bool match = ivol_on ? ivol_match :
+               greeks_match && __CHECK_FLOAT_MATCH(ref, dest, dataset_size, 1e-4);
   bool guard = __CHECK_GUARD(dest, dataset_size * sizeof(float));
+  if (ivol_on) {
+    guard = guard && __CHECK_GUARD(iters, dataset_size * sizeof(int));
+  }
+  if (greeks_on) {
+    guard = guard && __CHECK_GUARD(greeks.delta, dataset_size * sizeof(float))
+                  && __CHECK_GUARD(greeks.gamma, dataset_size * sizeof(float))
+                  && __CHECK_GUARD(greeks.vega , dataset_size * sizeof(float))
+                  && __CHECK_GUARD(greeks.theta, dataset_size * sizeof(float))
+                  && __CHECK_GUARD(greeks.rho  , dataset_size * sizeof(float));
+  }
 
   if (match && guard) {
     printf("Success\n");
@@ -437,6 +577,27 @@ int main(int argc, char** argv)
   /* Display information */
   printf("  * Runtimes (%s): ", __PRINT_MATCH(match));
   printf(" %" PRIu64 " ns\n"  , avg                 );
+  printf("  * Per option: %.2f ns (%.2f M options/s)\n",
+         (double)avg / dataset_size, 1e3 * dataset_size / avg);
+  if (impl == impl_parallel_ptr) {
+    /* Small datasets have fewer chunks than -n threads */
+    printf("  * Per core: %.2f M options/s (%d of %d threads)\n",
+           1e3 * dataset_size / avg / args.workers, args.workers, nthreads);
+  }
+  if (ivol_on) {
+    uint64_t total = 0;
+    int      most  = 0;
+    for (int i = 0; i < dataset_size; i++) {
+      total += iters[i];
+      if (iters[i] > most) most = iters[i];
+    }
+    printf("  * Iterations per option: %.2f (at most %d), %.2f ns per iteration\n",
+           (double)total / dataset_size, most, (double)avg / total);
+  }
+  if (layout_set) {
+    printf("  * Conversion + pricing (%s): %.2f ns per option\n",
+           bs_layout_name(layout), (double)(convert_avg + avg) / dataset_size);
+  }
 
   /* Dump */
   printf("  * Dumping runtime informations:\n");
@@ -481,6 +642,20 @@ int main(int argc, char** argv)
   free(volatility);
   free(otime);
   free(otype);
+  if (greeks_on) {
+    free(greeks.delta);
+    free(greeks.gamma);
+    free(greeks.vega);
+    free(greeks.theta);
+    free(greeks.rho);
+  }
+  if (ivol_on) {
+    free(iters);
+  }
+  if (layout_set) {
+    if (layout != BS_LAYOUT_AOS) free(args.records);
+    free(feed);
+  }
   free(dest);
   free(ref);
 
@@ -125,6 +125,20 @@
   __tmp;                                               \
 })
 
+/* Normwise relative error ||ref - array||_F / ||ref||_F, in double */
+#define __CALC_FLOAT_REL_ERROR(ref, array, sz) ({      \
+  double __num = 0.0;                                  \
+  double __den = 0.0;                                  \
+                                                       \
+  for(size_t i = 0; i < (size_t)(sz); i++) {           \
+    double __d = (double)ref[i] - (double)array[i];    \
+    __num += __d * __d;                                \
+    __den += (double)ref[i] * (double)ref[i];          \
+  }                                                    \
+                                                       \
+  (__den > 0.0) ? sqrt(__num / __den) : sqrt(__num);   \
+})
+
 #define __CHECK_GUARD(array, sz) ({                    \
   bool match = true;                                   \
                                                        \
@@ -0,0 +1,259 @@
+/* batch.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of batched small-matrix mmult
+ *
+ *  One call multiplies a whole batch of small (4x4 to 64x64) matrices,
+ *  so the per-call setup is paid once per batch instead of per GEMM.
+ *  Three layouts are supported:
+ *    - pointer array: A[b], B[b], C[b] point anywhere,
+ *    - strided      : matrix b starts at A + b * stride_a, and so on,
+ *    - compact      : groups of 8 matrices are interleaved so that one
+ *                     AVX register holds the same element of all 8.
+ *  The first two call the SIMD base case of vec.c per matrix. The
+ *  compact layout vectorizes across the batch instead, so the matrix
+ *  dimensions never leave a fringe: every size uses full vectors.
+ *
+ *  With more than one thread, the batch is split into contiguous ranges
+ *  (whole groups for the compact layout), one per pinned worker.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* If we are on Darwin, include the compatibility header */
+#if defined(__APPLE__)
+#include "common/mach_pthread_compatibility.h"
+#endif
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "vec.h"
+#include "batch.h"
+
+size_t batch_compact_size(size_t count, size_t rows, size_t cols)
+{
+  size_t groups = (count + BATCH_GROUP - 1) / BATCH_GROUP;
+  return groups * BATCH_GROUP * rows * cols;
+}
+
+void batch_pack_compact(size_t count, size_t rows, size_t cols,
+                        const float* src, float* dst)
+{
+  size_t groups = (count + BATCH_GROUP - 1) / BATCH_GROUP;
+  size_t elems  = rows * cols;
+
+  for (size_t g = 0; g < groups; g++) {
+    float* grp = &dst[g * elems * BATCH_GROUP];
+    for (size_t l = 0; l < BATCH_GROUP; l++) {
+      size_t b = g * BATCH_GROUP + l;
+      for (size_t e = 0; e < elems; e++) {
+        grp[e * BATCH_GROUP + l] = (b < count) ? src[b * elems + e] : 0.0f;
+      }
+    }
+  }
+}
+
+void batch_unpack_compact(size_t count, size_t rows, size_t cols,
+                          const float* src, float* dst)
+{
+  size_t elems = rows * cols;
+
+  for (size_t b = 0; b < count; b++) {
+    const float* grp = &src[(b / BATCH_GROUP) * elems * BATCH_GROUP];
+    for (size_t e = 0; e < elems; e++) {
+      dst[b * elems + e] = grp[e * BATCH_GROUP + (b % BATCH_GROUP)];
+    }
+  }
+}
+
+/* One GEMM of the pointer-array or strided layouts */
+static inline void small_gemm(size_t m, size_t n, size_t k,
+                              const float* A, const float* B, float* C)
+{
+  memset(C, 0, m * n * sizeof(float));
+  mmult_vec_kernel(m, n, k, A, k, B, n, C, n);
+}
+
+/* Compact layout: one group of 8 interleaved GEMMs */
+#if defined(__amd64__) || defined(__x86_64__)
+__attribute__((target("avx2,fma")))
+static void compact_group(size_t m, size_t n, size_t k,
+                          const float* A, const float* B, float* C)
+{
+  /* Four columns of C at a time keep four independent FMA chains */
+  for (size_t i = 0; i < m; i++) {
+    const float* a = &A[i * k * BATCH_GROUP];
+    size_t j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+      __m256 c0 = _mm256_setzero_ps();
+      __m256 c1 = _mm256_setzero_ps();
+      __m256 c2 = _mm256_setzero_ps();
+      __m256 c3 = _mm256_setzero_ps();
+
+      for (size_t p = 0; p < k; p++) {
+        __m256       av = _mm256_load_ps(&a[p * BATCH_GROUP]);
+        const float* b  = &B[(p * n + j) * BATCH_GROUP];
+        c0 = _mm256_fmadd_ps(av, _mm256_load_ps(&b[0 * BATCH_GROUP]), c0);
+        c1 = _mm256_fmadd_ps(av, _mm256_load_ps(&b[1 * BATCH_GROUP]), c1);
+        c2 = _mm256_fmadd_ps(av, _mm256_load_ps(&b[2 * BATCH_GROUP]), c2);
+        c3 = _mm256_fmadd_ps(av, _mm256_load_ps(&b[3 * BATCH_GROUP]), c3);
+      }
+
+      float* c = &C[(i * n + j) * BATCH_GROUP];
+      _mm256_store_ps(&c[0 * BATCH_GROUP], c0);
+      _mm256_store_ps(&c[1 * BATCH_GROUP], c1);
+      _mm256_store_ps(&c[2 * BATCH_GROUP], c2);
+      _mm256_store_ps(&c[3 * BATCH_GROUP], c3);
+    }
+
+    for (; j < n; j++) {
+      __m256 c0 = _mm256_setzero_ps();
+      for (size_t p = 0; p < k; p++) {
+        __m256 av = _mm256_load_ps(&a[p * BATCH_GROUP]);
+        __m256 bv = _mm256_load_ps(&B[(p * n + j) * BATCH_GROUP]);
+        c0 = _mm256_fmadd_ps(av, bv, c0);
+      }
+      _mm256_store_ps(&C[(i * n + j) * BATCH_GROUP], c0);
+    }
+  }
+}
+#else
+static void compact_group(size_t m, size_t n, size_t k,
+                          const float* A, const float* B, float* C)
+{
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      for (size_t l = 0; l < BATCH_GROUP; l++) {
+        float sum = 0.0f;
+        for (size_t p = 0; p < k; p++) {
+          sum += A[(i * k + p) * BATCH_GROUP + l] *
+                 B[(p * n + j) * BATCH_GROUP + l];
+        }
+        C[(i * n + j) * BATCH_GROUP + l] = sum;
+      }
+    }
+  }
+}
+#endif
+
+/* Multiply matrices [first, last) of the batch */
+static void batch_range(const batch_args_t* ba, size_t first, size_t last)
+{
+  const size_t m = ba->m, n = ba->n, k = ba->k;
+
+  switch (ba->layout) {
+    case BATCH_LAYOUT_PTR:
+      for (size_t b = first; b < last; b++) {
+        small_gemm(m, n, k, ba->a_array[b], ba->b_array[b], ba->c_array[b]);
+      }
+      break;
+
+    case BATCH_LAYOUT_STRIDED:
+      for (size_t b = first; b < last; b++) {
+        small_gemm(m, n, k, &ba->a[b * ba->stride_a],
+                            &ba->b[b * ba->stride_b],
+                            &ba->c[b * ba->stride_c]);
+      }
+      break;
+
+    case BATCH_LAYOUT_COMPACT:
+      /* first and last are group indices here */
+      for (size_t g = first; g < last; g++) {
+        compact_group(m, n, k, &ba->a[g * m * k * BATCH_GROUP],
+                               &ba->b[g * k * n * BATCH_GROUP],
+                               &ba->c[g * m * n * BATCH_GROUP]);
+      }
+      break;
+  }
+}
+
+/* Per-thread work */
+typedef struct {
+  const batch_args_t* ba;
+  size_t              first;
+  size_t              last;
+  int                 cpu;
+} batch_work_t;
+
+static void* batch_worker(void* args)
+{
+  batch_work_t* w = (batch_work_t*)args;
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(w->cpu, &cpuset);
+  int __attribute__((unused)) res = pthread_setaffinity_np(pthread_self(),
+                                                sizeof(cpuset), &cpuset);
+  batch_range(w->ba, w->first, w->last);
+
+  return NULL;
+}
+
+/* Batched Implementation */
+void* impl_mmult_batch(void* args)
+{
+  /* Get the argument struct */
+  batch_args_t* ba = (batch_args_t*)args;
+
+  /* Work items: matrices, or groups for the compact layout */
+  size_t items = ba->count;
+  if (ba->layout == BATCH_LAYOUT_COMPACT) {
+    items = (ba->count + BATCH_GROUP - 1) / BATCH_GROUP;
+  }
+
+  int nthreads = ba->nthreads;
+  if (nthreads < 1) nthreads = 1;
+  if ((size_t)nthreads > items) nthreads = items > 0 ? (int)items : 1;
+
+  if (nthreads == 1) {
+    batch_range(ba, 0, items);
+    return NULL;
+  }
+
+  pthread_t    tid[nthreads];
+  batch_work_t work[nthreads];
+
+  size_t per_thread = items / nthreads;
+  size_t remaining  = items % nthreads;
+  size_t first      = 0;
+
+  for (int t = 0; t < nthreads; t++) {
+    size_t cnt = per_thread + ((size_t)t < remaining ? 1 : 0);
+    work[t].ba    = ba;
+    work[t].first = first;
+    work[t].last  = first + cnt;
+    work[t].cpu   = ba->cpu + t;
+    first += cnt;
+
+    if (t > 0) {
+      int __attribute__((unused)) res = \
+                   pthread_create(&tid[t], NULL, batch_worker, (void*)&work[t]);
+    }
+  }
+
+  /* The calling thread takes the first range */
+  batch_range(ba, work[0].first, work[0].last);
+
+  for (int t = 1; t < nthreads; t++) {
+    pthread_join(tid[t], NULL);
+  }
+
+  return NULL;
+}
@@ -0,0 +1,33 @@
+/* batch.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the batched small-matrix mmult function.
+ */
+
+#ifndef __IMPL_BATCH_H_
+#define __IMPL_BATCH_H_
+
+/* Standard C includes */
+#include <stddef.h>
+
+/* Matrices interleaved per group in the compact layout */
+#define BATCH_GROUP 8
+
+/* Default per-matrix dimension and batch size */
+#define BATCH_DEFAULT_DIM   16
+#define BATCH_DEFAULT_COUNT 4096
+
+/* Function declaration */
+void* impl_mmult_batch(void* args);
+
+/* Compact layout converters: element (i, j) of matrices 8g..8g+7 is  *
+ * stored contiguously; the last group is zero-padded                 */
+size_t batch_compact_size  (size_t count, size_t rows, size_t cols);
+void   batch_pack_compact  (size_t count, size_t rows, size_t cols,
+                            const float* src, float* dst);
+void   batch_unpack_compact(size_t count, size_t rows, size_t cols,
+                            const float* src, float* dst);
+
+#endif //__IMPL_BATCH_H_
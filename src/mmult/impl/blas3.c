@@ -0,0 +1,409 @@
+/* blas3.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of SYRK, TRMM, and TRSM
+ *
+ *  All three are cut into BLAS3_NB-row blocks. Every off-diagonal
+ *  block is a plain product and goes through the vec kernel (with the
+ *  VEC_* cache blocking); only the small diagonal blocks need special
+ *  code. The blocks on the far side of the diagonal are never touched,
+ *  which is where the halved flop count comes from:
+ *
+ *  SYRK  C(I, J) = A(I, :) * A(J, :)^T for J < I, and the lower half
+ *        of the diagonal block (computed whole into a scratch tile).
+ *        A^T is packed once so the kernel sees a row-major B. Block
+ *        row I costs ~I, so the threads get row ranges of equal area.
+ *  TRMM  B(I, :) = L(I, <I) * B(<I, :) + L(I, I) * B(I, :), from the
+ *        bottom block up, so the rows it reads are still the inputs.
+ *  TRSM  B(I, :) = L(I, I)^-1 (B(I, :) - L(I, <I) * X(<I, :)), from
+ *        the top block down (forward substitution by blocks).
+ *  The columns of B are independent in TRMM and TRSM, so the threads
+ *  split them, in whole VEC_NR strips.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "vec.h"
+#include "para.h"
+#include "blas3.h"
+
+static inline size_t min(size_t a, size_t b)
+{
+  return (a < b) ? a : b;
+}
+
+/* C += A * B through the vec kernel, with its cache blocking */
+static void blocked_product(size_t m, size_t n, size_t k,
+                            const float* A, size_t lda,
+                            const float* B, size_t ldb,
+                                  float* C, size_t ldc)
+{
+  for (size_t jj = 0; jj < n; jj += VEC_NC) {
+    size_t nc = min(VEC_NC, n - jj);
+    for (size_t kk = 0; kk < k; kk += VEC_KC) {
+      size_t kc = min(VEC_KC, k - kk);
+      mmult_vec_kernel(m, nc, kc, &A[kk], lda, &B[kk * ldb + jj], ldb, &C[jj], ldc);
+    }
+  }
+}
+
+/* SYRK */
+typedef struct {
+  size_t       m, k;
+  const float* A;
+  size_t       lda;
+  const float* At;   // k x m
+  float*       C;
+  size_t       ldc;
+} syrk_ctx_t;
+
+static void syrk_rows(void* ctx, size_t first, size_t last)
+{
+  syrk_ctx_t* s       = (syrk_ctx_t*)ctx;
+  float*      scratch = (float*)aligned_alloc(64, BLAS3_NB * BLAS3_NB * sizeof(float));
+
+  for (size_t ib = first; ib < last; ib += BLAS3_NB) {
+    size_t       mb = min(BLAS3_NB, last - ib);
+    const float* Ai = &s->A[ib * s->lda];
+    float*       Ci = &s->C[ib * s->ldc];
+
+    /* Left of the diagonal block */
+    for (size_t i = 0; i < mb; i++) memset(&Ci[i * s->ldc], 0, ib * sizeof(float));
+    blocked_product(mb, ib, s->k, Ai, s->lda, s->At, s->m, Ci, s->ldc);
+
+    /* The diagonal block, of which the lower half is kept */
+    memset(scratch, 0, BLAS3_NB * BLAS3_NB * sizeof(float));
+    blocked_product(mb, mb, s->k, Ai, s->lda, &s->At[ib], s->m, scratch, BLAS3_NB);
+    for (size_t i = 0; i < mb; i++) {
+      memcpy(&Ci[i * s->ldc + ib], &scratch[i * BLAS3_NB], (i + 1) * sizeof(float));
+    }
+  }
+
+  free(scratch);
+}
+
+void mmult_syrk(size_t m, size_t k, const float* A, size_t lda,
+                float* C, size_t ldc, int nthreads, int cpu)
+{
+  float* At = (float*)aligned_alloc(64, ((k * m * sizeof(float) + 63) / 64) * 64);
+
+  for (size_t ii = 0; ii < m; ii += 32) {
+    for (size_t pp = 0; pp < k; pp += 32) {
+      for (size_t i = ii; i < min(ii + 32, m); i++) {
+        for (size_t p = pp; p < min(pp + 32, k); p++) {
+          At[p * m + i] = A[i * lda + p];
+        }
+      }
+    }
+  }
+
+  /* Row ranges of equal triangle area, in whole blocks */
+  size_t nblocks = (m + BLAS3_NB - 1) / BLAS3_NB;
+  if (nthreads < 1) nthreads = 1;
+  if ((size_t)nthreads > nblocks) nthreads = nblocks > 0 ? (int)nblocks : 1;
+
+  size_t bounds[nthreads + 1];
+  bounds[0] = 0;
+  for (int t = 1; t < nthreads; t++) {
+    size_t b = (size_t)(nblocks * sqrt((double)t / nthreads) + 0.5);
+    if (b <= (bounds[t - 1] / BLAS3_NB)) b = bounds[t - 1] / BLAS3_NB + 1;
+    bounds[t] = min(b * BLAS3_NB, m);
+  }
+  bounds[nthreads] = m;
+
+  syrk_ctx_t ctx = { m, k, A, lda, At, C, ldc };
+  mmult_parallel_ranges(bounds, nthreads, cpu, syrk_rows, &ctx);
+
+  free(At);
+}
+
+/* TRMM and TRSM, over a range of columns of B */
+typedef struct {
+  size_t       m;
+  const float* L;
+  size_t       ldl;
+  float*       B;
+  size_t       ldb;
+} tri_ctx_t;
+
+static void trmm_cols(void* ctx, size_t first, size_t last)
+{
+  tri_ctx_t* t = (tri_ctx_t*)ctx;
+  size_t     w = last - first;
+  float*     scratch = (float*)aligned_alloc(64, ((BLAS3_NB * w * sizeof(float) + 63) / 64) * 64);
+
+  size_t nblocks = (t->m + BLAS3_NB - 1) / BLAS3_NB;
+  for (size_t b = nblocks; b-- > 0; ) {
+    size_t       ib = b * BLAS3_NB;
+    size_t       mb = min(BLAS3_NB, t->m - ib);
+    const float* Li = &t->L[ib * t->ldl];
+    float*       Bc = &t->B[first];
+
+    /* Rows above the block */
+    memset(scratch, 0, mb * w * sizeof(float));
+    blocked_product(mb, w, ib, Li, t->ldl, Bc, t->ldb, scratch, w);
+
+    /* The triangle on the diagonal */
+    for (size_t i = 0; i < mb; i++) {
+      float* row = &scratch[i * w];
+      for (size_t p = 0; p <= i; p++) {
+        float        l  = Li[i * t->ldl + ib + p];
+        const float* bp = &Bc[(ib + p) * t->ldb];
+        for (size_t j = 0; j < w; j++) row[j] += l * bp[j];
+      }
+    }
+
+    for (size_t i = 0; i < mb; i++) {
+      memcpy(&Bc[(ib + i) * t->ldb], &scratch[i * w], w * sizeof(float));
+    }
+  }
+
+  free(scratch);
+}
+
+static void trsm_cols(void* ctx, size_t first, size_t last)
+{
+  tri_ctx_t* t = (tri_ctx_t*)ctx;
+  size_t     w = last - first;
+  float*     scratch = (float*)aligned_alloc(64, ((BLAS3_NB * w * sizeof(float) + 63) / 64) * 64);
+
+  for (size_t ib = 0; ib < t->m; ib += BLAS3_NB) {
+    size_t       mb = min(BLAS3_NB, t->m - ib);
+    const float* Li = &t->L[ib * t->ldl];
+    float*       Bc = &t->B[first];
+
+    /* What the solved rows above contribute */
+    memset(scratch, 0, mb * w * sizeof(float));
+    blocked_product(mb, w, ib, Li, t->ldl, Bc, t->ldb, scratch, w);
+
+    /* Forward substitution within the block */
+    for (size_t i = 0; i < mb; i++) {
+      float*       row = &Bc[(ib + i) * t->ldb];
+      const float* sub = &scratch[i * w];
+      for (size_t j = 0; j < w; j++) row[j] -= sub[j];
+      for (size_t p = 0; p < i; p++) {
+        float        l  = Li[i * t->ldl + ib + p];
+        const float* xp = &Bc[(ib + p) * t->ldb];
+        for (size_t j = 0; j < w; j++) row[j] -= l * xp[j];
+      }
+      float d = Li[i * t->ldl + ib + i];
+      for (size_t j = 0; j < w; j++) row[j] /= d;
+    }
+  }
+
+  free(scratch);
+}
+
+/* Column ranges in whole VEC_NR strips */
+static void tri_parallel(size_t m, size_t n, const float* L, size_t ldl,
+                         float* B, size_t ldb, int nthreads, int cpu,
+                         void (*fn)(void* ctx, size_t first, size_t last))
+{
+  size_t strips = (n + VEC_NR - 1) / VEC_NR;
+  if (nthreads < 1) nthreads = 1;
+  if ((size_t)nthreads > strips) nthreads = strips > 0 ? (int)strips : 1;
+
+  size_t bounds[nthreads + 1];
+  for (int t = 0; t <= nthreads; t++) {
+    bounds[t] = min((strips * t / nthreads) * VEC_NR, n);
+  }
+
+  tri_ctx_t ctx = { m, L, ldl, B, ldb };
+  mmult_parallel_ranges(bounds, nthreads, cpu, fn, &ctx);
+}
+
+void mmult_trmm(size_t m, size_t n, const float* L, size_t ldl,
+                float* B, size_t ldb, int nthreads, int cpu)
+{
+  tri_parallel(m, n, L, ldl, B, ldb, nthreads, cpu, trmm_cols);
+}
+
+void mmult_trsm(size_t m, size_t n, const float* L, size_t ldl,
+                float* B, size_t ldb, int nthreads, int cpu)
+{
+  tri_parallel(m, n, L, ldl, B, ldb, nthreads, cpu, trsm_cols);
+}
+
+/* The driver compares whole matrices: mirror SYRK's lower triangle */
+static void mirror_lower(size_t m, float* C, size_t ldc)
+{
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = i + 1; j < m; j++) {
+      C[i * ldc + j] = C[j * ldc + i];
+    }
+  }
+}
+
+/* Naive SYRK Implementation */
+#pragma GCC push_options
+#pragma GCC optimize ("O1")
+void* impl_syrk_naive(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  const float* A = parsed_args->input_a;
+        float* C = parsed_args->output;
+  size_t       m = parsed_args->rowsA;
+  size_t       k = parsed_args->colsA;
+
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j <= i; j++) {
+      float sum = 0.0f;
+      for (size_t p = 0; p < k; p++) {
+        sum += A[i * k + p] * A[j * k + p];
+      }
+      C[i * m + j] = sum;
+    }
+  }
+  mirror_lower(m, C, m);
+
+  return NULL;
+}
+#pragma GCC pop_options
+
+/* Parallel SYRK Implementation */
+void* impl_syrk_para(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  size_t m = parsed_args->rowsA;
+  size_t k = parsed_args->colsA;
+
+  mmult_syrk(m, k, parsed_args->input_a, k, parsed_args->output, m,
+             parsed_args->nthreads, parsed_args->cpu);
+  mirror_lower(m, parsed_args->output, m);
+
+  return NULL;
+}
+
+/* Naive TRMM Implementation: the output starts as a copy of B. Row i *
+ * reads rows <= i, so going bottom up keeps them unmodified           */
+#pragma GCC push_options
+#pragma GCC optimize ("O1")
+void* impl_trmm_naive(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  const float* L = parsed_args->input_a;
+        float* B = parsed_args->output;
+  size_t       m = parsed_args->rowsA;
+  size_t       n = parsed_args->colsB;
+
+  memcpy(B, parsed_args->input_b, m * n * sizeof(float));
+
+  for (size_t i = m; i-- > 0; ) {
+    for (size_t j = 0; j < n; j++) {
+      float sum = 0.0f;
+      for (size_t p = 0; p <= i; p++) {
+        sum += L[i * m + p] * B[p * n + j];
+      }
+      B[i * n + j] = sum;
+    }
+  }
+
+  return NULL;
+}
+#pragma GCC pop_options
+
+/* Parallel TRMM Implementation */
+void* impl_trmm_para(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  size_t m = parsed_args->rowsA;
+  size_t n = parsed_args->colsB;
+
+  memcpy(parsed_args->output, parsed_args->input_b, m * n * sizeof(float));
+  mmult_trmm(m, n, parsed_args->input_a, m, parsed_args->output, n,
+             parsed_args->nthreads, parsed_args->cpu);
+
+  return NULL;
+}
+
+/* Naive TRSM Implementation: forward substitution, top down */
+#pragma GCC push_options
+#pragma GCC optimize ("O1")
+void* impl_trsm_naive(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  const float* L = parsed_args->input_a;
+        float* B = parsed_args->output;
+  size_t       m = parsed_args->rowsA;
+  size_t       n = parsed_args->colsB;
+
+  memcpy(B, parsed_args->input_b, m * n * sizeof(float));
+
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      float x = B[i * n + j];
+      for (size_t p = 0; p < i; p++) {
+        x -= L[i * m + p] * B[p * n + j];
+      }
+      B[i * n + j] = x / L[i * m + i];
+    }
+  }
+
+  return NULL;
+}
+#pragma GCC pop_options
+
+/* Parallel TRSM Implementation */
+void* impl_trsm_para(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  size_t m = parsed_args->rowsA;
+  size_t n = parsed_args->colsB;
+
+  memcpy(parsed_args->output, parsed_args->input_b, m * n * sizeof(float));
+  mmult_trsm(m, n, parsed_args->input_a, m, parsed_args->output, n,
+             parsed_args->nthreads, parsed_args->cpu);
+
+  return NULL;
+}
+
+void blas3_setup(blas3_op_t op, float* A, float* B,
+                 size_t m, size_t k, size_t n)
+{
+  if (op == BLAS3_SYRK) {
+    for (size_t i = 0; i < m; i++) {
+      for (size_t p = 0; p < k; p++) B[p * n + i] = A[i * k + p];
+    }
+    return;
+  }
+
+  /* Off-diagonal entries in [0, 1/m) and a diagonal in [1, 2): each *
+   * row of L is dominated by its diagonal, so L^-1 is well behaved  */
+  for (size_t i = 0; i < m; i++) {
+    for (size_t p = 0; p < m; p++) {
+      float u = A[i * m + p] * 0x1p-31f;
+      A[i * m + p] = (p < i) ? u / m : (p == i) ? 1.0f + u : 0.0f;
+    }
+  }
+}
+
+double blas3_flops(blas3_op_t op, size_t m, size_t k, size_t n)
+{
+  /* SYRK computes the m (m + 1) / 2 entries of the lower triangle; *
+   * TRMM and TRSM touch the m (m + 1) / 2 entries of L per column  */
+  return (op == BLAS3_SYRK) ? (double)m * (m + 1) * k
+                            : (double)m * (m + 1) * n;
+}
@@ -0,0 +1,51 @@
+/* blas3.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the structured level-3 routines beyond GEMM: symmetric
+ * rank-k update (SYRK) and triangular multiply (TRMM) and solve (TRSM).
+ */
+
+#ifndef __IMPL_BLAS3_H_
+#define __IMPL_BLAS3_H_
+
+/* Standard C includes */
+#include <stddef.h>
+
+/* Rows per diagonal block (a multiple of VEC_MR) */
+#define BLAS3_NB 96
+
+typedef enum {
+  BLAS3_SYRK,   // C = A * A^T, lower triangle of the m x m C from m x k A
+  BLAS3_TRMM,   // B = L * B,   m x m lower-triangular L, m x n B
+  BLAS3_TRSM    // B = L^-1 * B (solves L * X = B in place)
+} blas3_op_t;
+
+/* Function declaration */
+void* impl_syrk_naive(void* args);
+void* impl_syrk_para(void* args);
+void* impl_trmm_naive(void* args);
+void* impl_trmm_para(void* args);
+void* impl_trsm_naive(void* args);
+void* impl_trsm_para(void* args);
+
+/* Row-major, no transposes, non-unit diagonal. SYRK writes the lower *
+ * triangle of C only; TRMM and TRSM read the lower triangle of L only */
+void  mmult_syrk(size_t m, size_t k, const float* A, size_t lda,
+                 float* C, size_t ldc, int nthreads, int cpu);
+void  mmult_trmm(size_t m, size_t n, const float* L, size_t ldl,
+                 float* B, size_t ldb, int nthreads, int cpu);
+void  mmult_trsm(size_t m, size_t n, const float* L, size_t ldl,
+                 float* B, size_t ldb, int nthreads, int cpu);
+
+/* Driver setup, so the GEMM reference C = A * B checks the routine: *
+ * SYRK makes B = A^T; TRMM and TRSM make A a well-conditioned lower  *
+ * triangle (TRSM then takes that product as its right-hand side)     */
+void  blas3_setup(blas3_op_t op, float* A, float* B,
+                  size_t m, size_t k, size_t n);
+
+/* Flops the routine actually needs (GEMM needs 2 m k n) */
+double blas3_flops(blas3_op_t op, size_t m, size_t k, size_t n);
+
+#endif //__IMPL_BLAS3_H_
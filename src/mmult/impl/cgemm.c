@@ -0,0 +1,440 @@
+/* cgemm.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of complex-float mmult
+ *
+ *  Two storage layouts are supported (see dtype_t):
+ *
+ *    interleaved -> (re, im) pairs, as in BLAS cgemm
+ *    split       -> a real plane followed by an imaginary plane
+ *
+ *  The naive and blocked (opt) variants address both through a pair of
+ *  base pointers and an element step, so one loop nest serves both.
+ *
+ *  The SIMD kernels differ per layout. Interleaved: each A element is
+ *  broadcast as its real and its imaginary part into two accumulators,
+ *  ar * [br, bi] and ai * [br, bi]; after the k loop the second one is
+ *  pair-swapped and combined with addsub, giving ar*br - ai*bi in the
+ *  even lanes and ar*bi + ai*br in the odd lanes. Split: real and
+ *  imaginary parts are separate vectors, so the product is four plain
+ *  FMAs per element and no shuffles at all.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "para.h"
+#include "cgemm.h"
+
+/* Cache blocking of vec (in complex elements) */
+#define CGEMM_MC  96
+#define CGEMM_KC 128
+#define CGEMM_NC 256
+
+/* Real and imaginary views of one r x c operand */
+typedef struct {
+  float* re;
+  float* im;
+  size_t step;   // 2 for interleaved pairs, 1 for planes
+} cview_t;
+
+static inline cview_t cview(float* base, size_t rows, size_t cols, dtype_t dtype)
+{
+  cview_t v;
+  bool    split = (dtype == DTYPE_COMPLEX_SPLIT);
+
+  v.re   = base;
+  v.im   = split ? base + rows * cols : base + 1;
+  v.step = split ? 1 : 2;
+
+  return v;
+}
+
+/* Naive Implementation */
+#pragma GCC push_options
+#pragma GCC optimize ("O1")
+void* impl_cgemm_naive(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  size_t  rowsA = parsed_args->rowsA;
+  size_t  colsA = parsed_args->colsA;
+  size_t  colsB = parsed_args->colsB;
+  cview_t A = cview(parsed_args->input_a, rowsA, colsA, parsed_args->dtype);
+  cview_t B = cview(parsed_args->input_b, colsA, colsB, parsed_args->dtype);
+  cview_t C = cview(parsed_args->output , rowsA, colsB, parsed_args->dtype);
+  size_t  s = A.step;
+
+  for (size_t i = 0; i < rowsA; i++) {
+    for (size_t j = 0; j < colsB; j++) {
+      float re = 0.0f;
+      float im = 0.0f;
+      for (size_t k = 0; k < colsA; k++) {
+        float ar = A.re[(i * colsA + k) * s], ai = A.im[(i * colsA + k) * s];
+        float br = B.re[(k * colsB + j) * s], bi = B.im[(k * colsB + j) * s];
+
+        re += ar * br - ai * bi;
+        im += ar * bi + ai * br;
+      }
+      C.re[(i * colsB + j) * s] = re;
+      C.im[(i * colsB + j) * s] = im;
+    }
+  }
+
+  return NULL;
+}
+
+/* Blocked Implementation, using the float blocking at half the kc */
+void* impl_cgemm_opt(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  size_t  rowsA = parsed_args->rowsA;
+  size_t  colsA = parsed_args->colsA;
+  size_t  colsB = parsed_args->colsB;
+  cview_t A = cview(parsed_args->input_a, rowsA, colsA, parsed_args->dtype);
+  cview_t B = cview(parsed_args->input_b, colsA, colsB, parsed_args->dtype);
+  cview_t C = cview(parsed_args->output , rowsA, colsB, parsed_args->dtype);
+  size_t  s = A.step;
+
+  size_t mc = parsed_args->blocking.mc     ? parsed_args->blocking.mc     : CGEMM_MC;
+  size_t kc = parsed_args->blocking.kc / 2 ? parsed_args->blocking.kc / 2 : CGEMM_KC;
+  size_t nc = parsed_args->blocking.nc     ? parsed_args->blocking.nc     : CGEMM_NC;
+
+  memset(parsed_args->output, 0, 2 * rowsA * colsB * sizeof(float));
+
+  for (size_t jj = 0; jj < colsB; jj += nc) {
+    size_t je = (jj + nc) < colsB ? (jj + nc) : colsB;
+    for (size_t kk = 0; kk < colsA; kk += kc) {
+      size_t ke = (kk + kc) < colsA ? (kk + kc) : colsA;
+      for (size_t ii = 0; ii < rowsA; ii += mc) {
+        size_t ie = (ii + mc) < rowsA ? (ii + mc) : rowsA;
+
+        /* i-k-j order streams rows of B and C */
+        for (size_t i = ii; i < ie; i++) {
+          for (size_t k = kk; k < ke; k++) {
+            float ar = A.re[(i * colsA + k) * s];
+            float ai = A.im[(i * colsA + k) * s];
+            for (size_t j = jj; j < je; j++) {
+              float br = B.re[(k * colsB + j) * s];
+              float bi = B.im[(k * colsB + j) * s];
+              C.re[(i * colsB + j) * s] += ar * br - ai * bi;
+              C.im[(i * colsB + j) * s] += ar * bi + ai * br;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+#pragma GCC pop_options
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Lane mask with the first 'lanes' lanes (0..8) active */
+static inline __m256i tail_mask(size_t lanes)
+{
+  const __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)lanes), idx);
+}
+
+/* C += (ar * B) addsub swap(ai * B), i.e. the complex product */
+__attribute__((target("avx2,fma")))
+static inline __m256 cplx_finish(__m256 c, __m256 acc_r, __m256 acc_i)
+{
+  return _mm256_add_ps(c, _mm256_addsub_ps(acc_r,
+                          _mm256_permute_ps(acc_i, 0xB1)));
+}
+
+/* Interleaved: C[3 x 8] += A[3 x k] * B[k x 8] (complex elements) */
+__attribute__((target("avx2,fma")))
+static void kernel_3x8(size_t k,
+                       const float* A, size_t lda,
+                       const float* B, size_t ldb,
+                             float* C, size_t ldc)
+{
+  __m256 r00 = _mm256_setzero_ps(), r01 = _mm256_setzero_ps();
+  __m256 i00 = _mm256_setzero_ps(), i01 = _mm256_setzero_ps();
+  __m256 r10 = _mm256_setzero_ps(), r11 = _mm256_setzero_ps();
+  __m256 i10 = _mm256_setzero_ps(), i11 = _mm256_setzero_ps();
+  __m256 r20 = _mm256_setzero_ps(), r21 = _mm256_setzero_ps();
+  __m256 i20 = _mm256_setzero_ps(), i21 = _mm256_setzero_ps();
+
+  for (size_t p = 0; p < k; p++) {
+    __m256 b0 = _mm256_loadu_ps(&B[2 * (p * ldb)    ]);
+    __m256 b1 = _mm256_loadu_ps(&B[2 * (p * ldb) + 8]);
+    __m256 a;
+
+    a = _mm256_broadcast_ss(&A[2 * (0 * lda + p)    ]);
+    r00 = _mm256_fmadd_ps(a, b0, r00); r01 = _mm256_fmadd_ps(a, b1, r01);
+    a = _mm256_broadcast_ss(&A[2 * (0 * lda + p) + 1]);
+    i00 = _mm256_fmadd_ps(a, b0, i00); i01 = _mm256_fmadd_ps(a, b1, i01);
+    a = _mm256_broadcast_ss(&A[2 * (1 * lda + p)    ]);
+    r10 = _mm256_fmadd_ps(a, b0, r10); r11 = _mm256_fmadd_ps(a, b1, r11);
+    a = _mm256_broadcast_ss(&A[2 * (1 * lda + p) + 1]);
+    i10 = _mm256_fmadd_ps(a, b0, i10); i11 = _mm256_fmadd_ps(a, b1, i11);
+    a = _mm256_broadcast_ss(&A[2 * (2 * lda + p)    ]);
+    r20 = _mm256_fmadd_ps(a, b0, r20); r21 = _mm256_fmadd_ps(a, b1, r21);
+    a = _mm256_broadcast_ss(&A[2 * (2 * lda + p) + 1]);
+    i20 = _mm256_fmadd_ps(a, b0, i20); i21 = _mm256_fmadd_ps(a, b1, i21);
+  }
+
+  float* c0 = &C[2 * (0 * ldc)];
+  float* c1 = &C[2 * (1 * ldc)];
+  float* c2 = &C[2 * (2 * ldc)];
+  _mm256_storeu_ps(&c0[0], cplx_finish(_mm256_loadu_ps(&c0[0]), r00, i00));
+  _mm256_storeu_ps(&c0[8], cplx_finish(_mm256_loadu_ps(&c0[8]), r01, i01));
+  _mm256_storeu_ps(&c1[0], cplx_finish(_mm256_loadu_ps(&c1[0]), r10, i10));
+  _mm256_storeu_ps(&c1[8], cplx_finish(_mm256_loadu_ps(&c1[8]), r11, i11));
+  _mm256_storeu_ps(&c2[0], cplx_finish(_mm256_loadu_ps(&c2[0]), r20, i20));
+  _mm256_storeu_ps(&c2[8], cplx_finish(_mm256_loadu_ps(&c2[8]), r21, i21));
+}
+
+/* Interleaved: C[1 x cols] += A[1 x k] * B[k x cols], cols <= 8 */
+__attribute__((target("avx2,fma")))
+static void kernel_1x8(size_t k, size_t cols,
+                       const float* A,
+                       const float* B, size_t ldb,
+                             float* C)
+{
+  /* Two float lanes per complex element */
+  __m256i m0 = tail_mask(cols > 4 ? 8 : 2 * cols);
+  __m256i m1 = tail_mask(cols > 4 ? 2 * (cols - 4) : 0);
+
+  __m256 r0 = _mm256_setzero_ps(), r1 = _mm256_setzero_ps();
+  __m256 i0 = _mm256_setzero_ps(), i1 = _mm256_setzero_ps();
+
+  for (size_t p = 0; p < k; p++) {
+    __m256 b0 = _mm256_maskload_ps(&B[2 * (p * ldb)    ], m0);
+    __m256 b1 = _mm256_maskload_ps(&B[2 * (p * ldb) + 8], m1);
+    __m256 ar = _mm256_broadcast_ss(&A[2 * p    ]);
+    __m256 ai = _mm256_broadcast_ss(&A[2 * p + 1]);
+    r0 = _mm256_fmadd_ps(ar, b0, r0); r1 = _mm256_fmadd_ps(ar, b1, r1);
+    i0 = _mm256_fmadd_ps(ai, b0, i0); i1 = _mm256_fmadd_ps(ai, b1, i1);
+  }
+
+  _mm256_maskstore_ps(&C[0], m0, cplx_finish(_mm256_maskload_ps(&C[0], m0), r0, i0));
+  _mm256_maskstore_ps(&C[8], m1, cplx_finish(_mm256_maskload_ps(&C[8], m1), r1, i1));
+}
+
+/* Split: C[4 x 8] += A[4 x k] * B[k x 8] */
+__attribute__((target("avx2,fma")))
+static void kernel_split_4x8(size_t k,
+                             const float* Ar, const float* Ai, size_t lda,
+                             const float* Br, const float* Bi, size_t ldb,
+                                   float* Cr,       float* Ci, size_t ldc)
+{
+  __m256 cr0 = _mm256_loadu_ps(&Cr[0 * ldc]), ci0 = _mm256_loadu_ps(&Ci[0 * ldc]);
+  __m256 cr1 = _mm256_loadu_ps(&Cr[1 * ldc]), ci1 = _mm256_loadu_ps(&Ci[1 * ldc]);
+  __m256 cr2 = _mm256_loadu_ps(&Cr[2 * ldc]), ci2 = _mm256_loadu_ps(&Ci[2 * ldc]);
+  __m256 cr3 = _mm256_loadu_ps(&Cr[3 * ldc]), ci3 = _mm256_loadu_ps(&Ci[3 * ldc]);
+
+  for (size_t p = 0; p < k; p++) {
+    __m256 br = _mm256_loadu_ps(&Br[p * ldb]);
+    __m256 bi = _mm256_loadu_ps(&Bi[p * ldb]);
+    __m256 ar, ai;
+
+#define SPLIT_ROW(r)                                          \
+    ar  = _mm256_broadcast_ss(&Ar[r * lda + p]);              \
+    ai  = _mm256_broadcast_ss(&Ai[r * lda + p]);              \
+    cr##r = _mm256_fmadd_ps (ar, br, cr##r);                  \
+    cr##r = _mm256_fnmadd_ps(ai, bi, cr##r);                  \
+    ci##r = _mm256_fmadd_ps (ar, bi, ci##r);                  \
+    ci##r = _mm256_fmadd_ps (ai, br, ci##r);
+
+    SPLIT_ROW(0) SPLIT_ROW(1) SPLIT_ROW(2) SPLIT_ROW(3)
+#undef SPLIT_ROW
+  }
+
+  _mm256_storeu_ps(&Cr[0 * ldc], cr0); _mm256_storeu_ps(&Ci[0 * ldc], ci0);
+  _mm256_storeu_ps(&Cr[1 * ldc], cr1); _mm256_storeu_ps(&Ci[1 * ldc], ci1);
+  _mm256_storeu_ps(&Cr[2 * ldc], cr2); _mm256_storeu_ps(&Ci[2 * ldc], ci2);
+  _mm256_storeu_ps(&Cr[3 * ldc], cr3); _mm256_storeu_ps(&Ci[3 * ldc], ci3);
+}
+
+/* Split: C[1 x cols] += A[1 x k] * B[k x cols], cols <= 8 */
+__attribute__((target("avx2,fma")))
+static void kernel_split_1x8(size_t k, size_t cols,
+                             const float* Ar, const float* Ai,
+                             const float* Br, const float* Bi, size_t ldb,
+                                   float* Cr,       float* Ci)
+{
+  __m256i m = tail_mask(cols);
+
+  __m256 cr = _mm256_maskload_ps(Cr, m);
+  __m256 ci = _mm256_maskload_ps(Ci, m);
+
+  for (size_t p = 0; p < k; p++) {
+    __m256 br = _mm256_maskload_ps(&Br[p * ldb], m);
+    __m256 bi = _mm256_maskload_ps(&Bi[p * ldb], m);
+    __m256 ar = _mm256_broadcast_ss(&Ar[p]);
+    __m256 ai = _mm256_broadcast_ss(&Ai[p]);
+    cr = _mm256_fmadd_ps (ar, br, cr);
+    cr = _mm256_fnmadd_ps(ai, bi, cr);
+    ci = _mm256_fmadd_ps (ar, bi, ci);
+    ci = _mm256_fmadd_ps (ai, br, ci);
+  }
+
+  _mm256_maskstore_ps(Cr, m, cr);
+  _mm256_maskstore_ps(Ci, m, ci);
+}
+#endif
+
+/* Interleaved: C[m x n] += A[m x k] * B[k x n], leading dims in elements */
+static void cgemm_kernel(size_t m, size_t n, size_t k,
+                         const float* A, size_t lda,
+                         const float* B, size_t ldb,
+                               float* C, size_t ldc)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  for (size_t j = 0; j < n; j += CGEMM_NR) {
+    size_t cols = (n - j) < CGEMM_NR ? (n - j) : CGEMM_NR;
+    size_t i    = 0;
+
+    if (cols == CGEMM_NR) {
+      for (; i + CGEMM_MR <= m; i += CGEMM_MR) {
+        kernel_3x8(k, &A[2 * (i * lda)], lda, &B[2 * j], ldb,
+                      &C[2 * (i * ldc + j)], ldc);
+      }
+    }
+
+    for (; i < m; i++) {
+      kernel_1x8(k, cols, &A[2 * (i * lda)], &B[2 * j], ldb,
+                          &C[2 * (i * ldc + j)]);
+    }
+  }
+#else
+  for (size_t i = 0; i < m; i++) {
+    for (size_t p = 0; p < k; p++) {
+      float ar = A[2 * (i * lda + p)], ai = A[2 * (i * lda + p) + 1];
+      for (size_t j = 0; j < n; j++) {
+        float br = B[2 * (p * ldb + j)], bi = B[2 * (p * ldb + j) + 1];
+        C[2 * (i * ldc + j)    ] += ar * br - ai * bi;
+        C[2 * (i * ldc + j) + 1] += ar * bi + ai * br;
+      }
+    }
+  }
+#endif
+}
+
+/* Split: C[m x n] += A[m x k] * B[k x n] */
+static void cgemm_split_kernel(size_t m, size_t n, size_t k,
+                               const float* Ar, const float* Ai, size_t lda,
+                               const float* Br, const float* Bi, size_t ldb,
+                                     float* Cr,       float* Ci, size_t ldc)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  for (size_t j = 0; j < n; j += CGEMM_SPLIT_NR) {
+    size_t cols = (n - j) < CGEMM_SPLIT_NR ? (n - j) : CGEMM_SPLIT_NR;
+    size_t i    = 0;
+
+    if (cols == CGEMM_SPLIT_NR) {
+      for (; i + CGEMM_SPLIT_MR <= m; i += CGEMM_SPLIT_MR) {
+        kernel_split_4x8(k, &Ar[i * lda], &Ai[i * lda], lda,
+                            &Br[j], &Bi[j], ldb,
+                            &Cr[i * ldc + j], &Ci[i * ldc + j], ldc);
+      }
+    }
+
+    for (; i < m; i++) {
+      kernel_split_1x8(k, cols, &Ar[i * lda], &Ai[i * lda],
+                                &Br[j], &Bi[j], ldb,
+                                &Cr[i * ldc + j], &Ci[i * ldc + j]);
+    }
+  }
+#else
+  for (size_t i = 0; i < m; i++) {
+    for (size_t p = 0; p < k; p++) {
+      float ar = Ar[i * lda + p], ai = Ai[i * lda + p];
+      for (size_t j = 0; j < n; j++) {
+        Cr[i * ldc + j] += ar * Br[p * ldb + j] - ai * Bi[p * ldb + j];
+        Ci[i * ldc + j] += ar * Bi[p * ldb + j] + ai * Br[p * ldb + j];
+      }
+    }
+  }
+#endif
+}
+
+/* Rows [first, last) of C, blocked around the base case of the layout */
+static void cgemm_rows(void* ctx, size_t first, size_t last)
+{
+  args_t* parsed_args = (args_t*)ctx;
+
+  size_t  rowsA = parsed_args->rowsA;
+  size_t  colsA = parsed_args->colsA;
+  size_t  colsB = parsed_args->colsB;
+  cview_t A = cview(parsed_args->input_a, rowsA, colsA, parsed_args->dtype);
+  cview_t B = cview(parsed_args->input_b, colsA, colsB, parsed_args->dtype);
+  cview_t C = cview(parsed_args->output , rowsA, colsB, parsed_args->dtype);
+  bool    split = (parsed_args->dtype == DTYPE_COMPLEX_SPLIT);
+
+  if (split) {
+    memset(&C.re[first * colsB], 0, (last - first) * colsB * sizeof(float));
+    memset(&C.im[first * colsB], 0, (last - first) * colsB * sizeof(float));
+  } else {
+    memset(&C.re[2 * first * colsB], 0, 2 * (last - first) * colsB * sizeof(float));
+  }
+
+  for (size_t jj = 0; jj < colsB; jj += CGEMM_NC) {
+    size_t nb = (colsB - jj) < CGEMM_NC ? (colsB - jj) : CGEMM_NC;
+    for (size_t kk = 0; kk < colsA; kk += CGEMM_KC) {
+      size_t kb = (colsA - kk) < CGEMM_KC ? (colsA - kk) : CGEMM_KC;
+      for (size_t ii = first; ii < last; ii += CGEMM_MC) {
+        size_t mb = (last - ii) < CGEMM_MC ? (last - ii) : CGEMM_MC;
+        if (split) {
+          cgemm_split_kernel(mb, nb, kb,
+                             &A.re[ii * colsA + kk], &A.im[ii * colsA + kk], colsA,
+                             &B.re[kk * colsB + jj], &B.im[kk * colsB + jj], colsB,
+                             &C.re[ii * colsB + jj], &C.im[ii * colsB + jj], colsB);
+        } else {
+          cgemm_kernel(mb, nb, kb,
+                       &A.re[2 * (ii * colsA + kk)], colsA,
+                       &B.re[2 * (kk * colsB + jj)], colsB,
+                       &C.re[2 * (ii * colsB + jj)], colsB);
+        }
+      }
+    }
+  }
+}
+
+/* Vectorized Implementation */
+void* impl_cgemm_vec(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  cgemm_rows(parsed_args, 0, parsed_args->rowsA);
+
+  return NULL;
+}
+
+/* Parallel Implementation */
+void* impl_cgemm_para(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  mmult_parallel_rows(parsed_args->rowsA, parsed_args->nthreads,
+                      parsed_args->cpu, cgemm_rows, parsed_args);
+
+  return NULL;
+}
@@ -0,0 +1,27 @@
+/* cgemm.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the complex-float implementations.
+ */
+
+#ifndef __IMPL_CGEMM_H_
+#define __IMPL_CGEMM_H_
+
+/* Standard C includes */
+#include <stddef.h>
+
+/* Register tiles of the SIMD base cases (in complex elements) */
+#define CGEMM_MR        3
+#define CGEMM_NR        8
+#define CGEMM_SPLIT_MR  4
+#define CGEMM_SPLIT_NR  8
+
+/* Function declaration; the layout comes from args_t.dtype */
+void* impl_cgemm_naive(void* args);
+void* impl_cgemm_opt(void* args);
+void* impl_cgemm_vec(void* args);
+void* impl_cgemm_para(void* args);
+
+#endif //__IMPL_CGEMM_H_
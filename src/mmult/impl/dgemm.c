@@ -0,0 +1,268 @@
+/* dgemm.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of double-precision mmult
+ *
+ *  The four variants mirror their float counterparts: a naive triple
+ *  loop, a cache-blocked scalar loop nest (opt), a SIMD version built
+ *  on a 6x8 register tile (vec), and the SIMD version split by rows
+ *  across pinned threads (para). A ymm register holds four doubles, so
+ *  the tile is half as wide as the float one for the same register use.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <string.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "vec.h"
+#include "para.h"
+#include "dgemm.h"
+
+/* Cache blocking of vec; kc is halved to keep the float footprint */
+#define DGEMM_MC  96
+#define DGEMM_KC 128
+#define DGEMM_NC 512
+
+/* Naive Implementation */
+#pragma GCC push_options
+#pragma GCC optimize ("O1")
+void* impl_dgemm_naive(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  const double* matA  = (const double*)parsed_args->input_a;
+  const double* matB  = (const double*)parsed_args->input_b;
+        double* dest  = (double*)parsed_args->output;
+  size_t        rowsA = parsed_args->rowsA;
+  size_t        colsA = parsed_args->colsA;
+  size_t        colsB = parsed_args->colsB;
+
+  for (size_t i = 0; i < rowsA; i++) {
+    for (size_t j = 0; j < colsB; j++) {
+      double sum = 0.0;
+      for (size_t k = 0; k < colsA; k++) {
+        sum += matA[i * colsA + k] * matB[k * colsB + j];
+      }
+      dest[i * colsB + j] = sum;
+    }
+  }
+
+  return NULL;
+}
+
+/* Blocked Implementation, using the float blocking at half the kc */
+void* impl_dgemm_opt(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  const double* matA  = (const double*)parsed_args->input_a;
+  const double* matB  = (const double*)parsed_args->input_b;
+        double* dest  = (double*)parsed_args->output;
+  size_t        rowsA = parsed_args->rowsA;
+  size_t        colsA = parsed_args->colsA;
+  size_t        colsB = parsed_args->colsB;
+
+  size_t mc = parsed_args->blocking.mc     ? parsed_args->blocking.mc     : DGEMM_MC;
+  size_t kc = parsed_args->blocking.kc / 2 ? parsed_args->blocking.kc / 2 : DGEMM_KC;
+  size_t nc = parsed_args->blocking.nc     ? parsed_args->blocking.nc     : DGEMM_NC;
+
+  memset(dest, 0, rowsA * colsB * sizeof(double));
+
+  for (size_t jj = 0; jj < colsB; jj += nc) {
+    size_t je = (jj + nc) < colsB ? (jj + nc) : colsB;
+    for (size_t kk = 0; kk < colsA; kk += kc) {
+      size_t ke = (kk + kc) < colsA ? (kk + kc) : colsA;
+      for (size_t ii = 0; ii < rowsA; ii += mc) {
+        size_t ie = (ii + mc) < rowsA ? (ii + mc) : rowsA;
+
+        /* i-k-j order streams rows of B and C */
+        for (size_t i = ii; i < ie; i++) {
+          for (size_t k = kk; k < ke; k++) {
+            double a = matA[i * colsA + k];
+            for (size_t j = jj; j < je; j++) {
+              dest[i * colsB + j] += a * matB[k * colsB + j];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+#pragma GCC pop_options
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Lane mask with the first 'cols' lanes (0..4) active */
+static inline __m256i tail_mask_pd(size_t cols)
+{
+  const __m256i idx = _mm256_setr_epi64x(0, 1, 2, 3);
+  return _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)cols), idx);
+}
+
+/* C[6 x 8] += A[6 x k] * B[k x 8] */
+__attribute__((target("avx2,fma")))
+static void kernel_6x8(size_t k,
+                       const double* A, size_t lda,
+                       const double* B, size_t ldb,
+                             double* C, size_t ldc)
+{
+  __m256d c00 = _mm256_loadu_pd(&C[0 * ldc]), c01 = _mm256_loadu_pd(&C[0 * ldc + 4]);
+  __m256d c10 = _mm256_loadu_pd(&C[1 * ldc]), c11 = _mm256_loadu_pd(&C[1 * ldc + 4]);
+  __m256d c20 = _mm256_loadu_pd(&C[2 * ldc]), c21 = _mm256_loadu_pd(&C[2 * ldc + 4]);
+  __m256d c30 = _mm256_loadu_pd(&C[3 * ldc]), c31 = _mm256_loadu_pd(&C[3 * ldc + 4]);
+  __m256d c40 = _mm256_loadu_pd(&C[4 * ldc]), c41 = _mm256_loadu_pd(&C[4 * ldc + 4]);
+  __m256d c50 = _mm256_loadu_pd(&C[5 * ldc]), c51 = _mm256_loadu_pd(&C[5 * ldc + 4]);
+
+  for (size_t p = 0; p < k; p++) {
+    __m256d b0 = _mm256_loadu_pd(&B[p * ldb    ]);
+    __m256d b1 = _mm256_loadu_pd(&B[p * ldb + 4]);
+    __m256d a;
+
+    a = _mm256_broadcast_sd(&A[0 * lda + p]);
+    c00 = _mm256_fmadd_pd(a, b0, c00); c01 = _mm256_fmadd_pd(a, b1, c01);
+    a = _mm256_broadcast_sd(&A[1 * lda + p]);
+    c10 = _mm256_fmadd_pd(a, b0, c10); c11 = _mm256_fmadd_pd(a, b1, c11);
+    a = _mm256_broadcast_sd(&A[2 * lda + p]);
+    c20 = _mm256_fmadd_pd(a, b0, c20); c21 = _mm256_fmadd_pd(a, b1, c21);
+    a = _mm256_broadcast_sd(&A[3 * lda + p]);
+    c30 = _mm256_fmadd_pd(a, b0, c30); c31 = _mm256_fmadd_pd(a, b1, c31);
+    a = _mm256_broadcast_sd(&A[4 * lda + p]);
+    c40 = _mm256_fmadd_pd(a, b0, c40); c41 = _mm256_fmadd_pd(a, b1, c41);
+    a = _mm256_broadcast_sd(&A[5 * lda + p]);
+    c50 = _mm256_fmadd_pd(a, b0, c50); c51 = _mm256_fmadd_pd(a, b1, c51);
+  }
+
+  _mm256_storeu_pd(&C[0 * ldc], c00); _mm256_storeu_pd(&C[0 * ldc + 4], c01);
+  _mm256_storeu_pd(&C[1 * ldc], c10); _mm256_storeu_pd(&C[1 * ldc + 4], c11);
+  _mm256_storeu_pd(&C[2 * ldc], c20); _mm256_storeu_pd(&C[2 * ldc + 4], c21);
+  _mm256_storeu_pd(&C[3 * ldc], c30); _mm256_storeu_pd(&C[3 * ldc + 4], c31);
+  _mm256_storeu_pd(&C[4 * ldc], c40); _mm256_storeu_pd(&C[4 * ldc + 4], c41);
+  _mm256_storeu_pd(&C[5 * ldc], c50); _mm256_storeu_pd(&C[5 * ldc + 4], c51);
+}
+
+/* C[1 x cols] += A[1 x k] * B[k x cols], cols <= 8 */
+__attribute__((target("avx2,fma")))
+static void kernel_1x8(size_t k, size_t cols,
+                       const double* A,
+                       const double* B, size_t ldb,
+                             double* C)
+{
+  __m256i m0 = tail_mask_pd(cols > 4 ? 4 : cols);
+  __m256i m1 = tail_mask_pd(cols > 4 ? cols - 4 : 0);
+
+  __m256d c0 = _mm256_maskload_pd(&C[0], m0);
+  __m256d c1 = _mm256_maskload_pd(&C[4], m1);
+
+  for (size_t p = 0; p < k; p++) {
+    __m256d a  = _mm256_broadcast_sd(&A[p]);
+    __m256d b0 = _mm256_maskload_pd(&B[p * ldb    ], m0);
+    __m256d b1 = _mm256_maskload_pd(&B[p * ldb + 4], m1);
+    c0 = _mm256_fmadd_pd(a, b0, c0);
+    c1 = _mm256_fmadd_pd(a, b1, c1);
+  }
+
+  _mm256_maskstore_pd(&C[0], m0, c0);
+  _mm256_maskstore_pd(&C[4], m1, c1);
+}
+#endif
+
+/* C[m x n] += A[m x k] * B[k x n] with the 6x8 base case */
+void mmult_dgemm_kernel(size_t m, size_t n, size_t k,
+                        const double* A, size_t lda,
+                        const double* B, size_t ldb,
+                              double* C, size_t ldc)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  for (size_t j = 0; j < n; j += DGEMM_NR) {
+    size_t cols = (n - j) < DGEMM_NR ? (n - j) : DGEMM_NR;
+    size_t i    = 0;
+
+    if (cols == DGEMM_NR) {
+      for (; i + DGEMM_MR <= m; i += DGEMM_MR) {
+        kernel_6x8(k, &A[i * lda], lda, &B[j], ldb, &C[i * ldc + j], ldc);
+      }
+    }
+
+    for (; i < m; i++) {
+      kernel_1x8(k, cols, &A[i * lda], &B[j], ldb, &C[i * ldc + j]);
+    }
+  }
+#else
+  for (size_t i = 0; i < m; i++) {
+    for (size_t p = 0; p < k; p++) {
+      double a = A[i * lda + p];
+      for (size_t j = 0; j < n; j++) {
+        C[i * ldc + j] += a * B[p * ldb + j];
+      }
+    }
+  }
+#endif
+}
+
+/* Rows [first, last) of C, blocked around the base case */
+static void dgemm_rows(void* ctx, size_t first, size_t last)
+{
+  args_t* parsed_args = (args_t*)ctx;
+
+  const double* matA  = (const double*)parsed_args->input_a;
+  const double* matB  = (const double*)parsed_args->input_b;
+        double* dest  = (double*)parsed_args->output;
+  size_t        colsA = parsed_args->colsA;
+  size_t        colsB = parsed_args->colsB;
+
+  memset(&dest[first * colsB], 0, (last - first) * colsB * sizeof(double));
+
+  for (size_t jj = 0; jj < colsB; jj += DGEMM_NC) {
+    size_t nb = (colsB - jj) < DGEMM_NC ? (colsB - jj) : DGEMM_NC;
+    for (size_t kk = 0; kk < colsA; kk += DGEMM_KC) {
+      size_t kb = (colsA - kk) < DGEMM_KC ? (colsA - kk) : DGEMM_KC;
+      for (size_t ii = first; ii < last; ii += DGEMM_MC) {
+        size_t mb = (last - ii) < DGEMM_MC ? (last - ii) : DGEMM_MC;
+        mmult_dgemm_kernel(mb, nb, kb,
+                           &matA[ii * colsA + kk], colsA,
+                           &matB[kk * colsB + jj], colsB,
+                           &dest[ii * colsB + jj], colsB);
+      }
+    }
+  }
+}
+
+/* Vectorized Implementation */
+void* impl_dgemm_vec(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  dgemm_rows(parsed_args, 0, parsed_args->rowsA);
+
+  return NULL;
+}
+
+/* Parallel Implementation */
+void* impl_dgemm_para(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  mmult_parallel_rows(parsed_args->rowsA, parsed_args->nthreads,
+                      parsed_args->cpu, dgemm_rows, parsed_args);
+
+  return NULL;
+}
@@ -0,0 +1,31 @@
+/* dgemm.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the double-precision implementations.
+ */
+
+#ifndef __IMPL_DGEMM_H_
+#define __IMPL_DGEMM_H_
+
+/* Standard C includes */
+#include <stddef.h>
+
+/* Register tile of the SIMD base case */
+#define DGEMM_MR 6
+#define DGEMM_NR 8
+
+/* Function declaration */
+void* impl_dgemm_naive(void* args);
+void* impl_dgemm_opt(void* args);
+void* impl_dgemm_vec(void* args);
+void* impl_dgemm_para(void* args);
+
+/* C[m x n] += A[m x k] * B[k x n] */
+void  mmult_dgemm_kernel(size_t m, size_t n, size_t k,
+                         const double* A, size_t lda,
+                         const double* B, size_t ldb,
+                               double* C, size_t ldc);
+
+#endif //__IMPL_DGEMM_H_
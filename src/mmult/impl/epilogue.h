@@ -0,0 +1,106 @@
+/* epilogue.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Element-wise GEMM epilogue (bias, activation, scaling, and 16-bit
+ * conversion), inlined into the kernels so it runs on values that are
+ * still in registers instead of in a second pass over C.
+ */
+
+#ifndef __IMPL_EPILOGUE_H_
+#define __IMPL_EPILOGUE_H_
+
+/* Standard C includes */
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Scalar conversions */
+static inline uint16_t float_to_bf16(float x)
+{
+  uint32_t u;
+  memcpy(&u, &x, sizeof(u));
+  u += 0x7fff + ((u >> 16) & 1);   /* round to nearest even */
+  return (uint16_t)(u >> 16);
+}
+
+static inline float bf16_to_float(uint16_t h)
+{
+  uint32_t u = (uint32_t)h << 16;
+  float    x;
+  memcpy(&x, &u, sizeof(x));
+  return x;
+}
+
+#if defined(__amd64__) || defined(__x86_64__)
+__attribute__((target("f16c")))
+static inline uint16_t float_to_fp16(float x)
+{
+  return _cvtss_sh(x, _MM_FROUND_TO_NEAREST_INT);
+}
+
+__attribute__((target("f16c")))
+static inline float fp16_to_float(uint16_t h)
+{
+  return _cvtsh_ss(h);
+}
+#endif
+
+/* The defaults: no bias, no activation, unit scale, float output */
+static inline void epilogue_init(epilogue_t* epi)
+{
+  epi->bias      = NULL;
+  epi->act       = ACT_NONE;
+  epi->scale     = 1.0f;
+  epi->cvt       = CVT_NONE;
+  epi->converted = NULL;
+}
+
+static inline bool epilogue_is_identity(const epilogue_t* epi)
+{
+  return epi->bias == NULL && epi->act == ACT_NONE &&
+         epi->scale == 1.0f && epi->cvt == CVT_NONE;
+}
+
+/* scale * act(v + bias[col]) */
+static inline float epilogue_apply(const epilogue_t* epi, float v, size_t col)
+{
+  if (epi->bias != NULL) {
+    v += epi->bias[col];
+  }
+
+  if (epi->act == ACT_RELU) {
+    v = v > 0.0f ? v : 0.0f;
+  } else if (epi->act == ACT_GELU) {
+    v = 0.5f * v * (1.0f + erff(v * (float)M_SQRT1_2));
+  }
+
+  return v * epi->scale;
+}
+
+/* Apply the epilogue to C(row, col) = v and store it where it belongs */
+static inline void epilogue_store(const epilogue_t* epi, float v,
+                                  float* C, size_t row, size_t col, size_t ldc)
+{
+  v = epilogue_apply(epi, v, col);
+
+  if (epi->cvt == CVT_BF16) {
+    epi->converted[row * ldc + col] = float_to_bf16(v);
+#if defined(__amd64__) || defined(__x86_64__)
+  } else if (epi->cvt == CVT_FP16) {
+    epi->converted[row * ldc + col] = float_to_fp16(v);
+#endif
+  } else {
+    C[row * ldc + col] = v;
+  }
+}
+
+#endif //__IMPL_EPILOGUE_H_
@@ -0,0 +1,278 @@
+/* gemv.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of GEMV and skinny mmult
+ *
+ *  With 16 or fewer rows in A, or columns in B, each element of the big
+ *  operand is used at most 16 times, so the product is bound by how fast
+ *  that operand streams from memory. Register tiling does not help here.
+ *  What helps is keeping several independent streams and accumulator
+ *  chains in flight. There are three paths:
+ *
+ *    colsB == 1       -> y = A x as dot products, four rows of A
+ *                        streamed at once with two accumulators each
+ *    colsB <= 16      -> four rows of A at once against the (cached) B,
+ *                        one broadcast per A element
+ *    rowsA <= 16      -> B streamed four rows at a time into a strip
+ *                        of C sized to stay in L1
+ *
+ *  When both are small, the path that streams the larger operand wins.
+ *  Any other shape falls back to the vectorized implementation.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <string.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "vec.h"
+#include "gemv.h"
+
+/* Floats of C kept hot per strip on the rowsA <= 16 path */
+#define GEMV_STRIP_FLOATS 4096
+
+bool mmult_gemv_skinny(size_t rowsA, size_t colsB)
+{
+  return rowsA <= GEMV_MAX_SKINNY || colsB <= GEMV_MAX_SKINNY;
+}
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Lane mask with the first 'cols' lanes (0..8) active */
+static inline __m256i tail_mask(size_t cols)
+{
+  const __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)cols), idx);
+}
+
+__attribute__((target("avx2,fma")))
+static inline float hsum(__m256 v)
+{
+  __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+  s = _mm_add_ss(s, _mm_movehdup_ps(s));
+  return _mm_cvtss_f32(s);
+}
+
+/* y[0 .. rows) = A[rows x k] . x, rows <= 4 */
+__attribute__((target("avx2,fma")))
+static void kernel_dot(size_t rows, size_t k,
+                       const float* A, size_t lda,
+                       const float* x, float* y, size_t ldy)
+{
+  __m256 acc[4][2];
+  for (size_t i = 0; i < 4; i++) {
+    acc[i][0] = _mm256_setzero_ps();
+    acc[i][1] = _mm256_setzero_ps();
+  }
+
+  size_t p = 0;
+  if (rows == 4) {
+    /* The common case, spelled out so everything stays in registers */
+    for (; p + 16 <= k; p += 16) {
+      __m256 x0 = _mm256_loadu_ps(&x[p]);
+      __m256 x1 = _mm256_loadu_ps(&x[p + 8]);
+      acc[0][0] = _mm256_fmadd_ps(_mm256_loadu_ps(&A[0 * lda + p    ]), x0, acc[0][0]);
+      acc[0][1] = _mm256_fmadd_ps(_mm256_loadu_ps(&A[0 * lda + p + 8]), x1, acc[0][1]);
+      acc[1][0] = _mm256_fmadd_ps(_mm256_loadu_ps(&A[1 * lda + p    ]), x0, acc[1][0]);
+      acc[1][1] = _mm256_fmadd_ps(_mm256_loadu_ps(&A[1 * lda + p + 8]), x1, acc[1][1]);
+      acc[2][0] = _mm256_fmadd_ps(_mm256_loadu_ps(&A[2 * lda + p    ]), x0, acc[2][0]);
+      acc[2][1] = _mm256_fmadd_ps(_mm256_loadu_ps(&A[2 * lda + p + 8]), x1, acc[2][1]);
+      acc[3][0] = _mm256_fmadd_ps(_mm256_loadu_ps(&A[3 * lda + p    ]), x0, acc[3][0]);
+      acc[3][1] = _mm256_fmadd_ps(_mm256_loadu_ps(&A[3 * lda + p + 8]), x1, acc[3][1]);
+    }
+  }
+  for (; p + 8 <= k; p += 8) {
+    __m256 x0 = _mm256_loadu_ps(&x[p]);
+    for (size_t i = 0; i < rows; i++) {
+      acc[i][0] = _mm256_fmadd_ps(_mm256_loadu_ps(&A[i * lda + p]), x0, acc[i][0]);
+    }
+  }
+  if (p < k) {
+    __m256i m  = tail_mask(k - p);
+    __m256  x0 = _mm256_maskload_ps(&x[p], m);
+    for (size_t i = 0; i < rows; i++) {
+      acc[i][1] = _mm256_fmadd_ps(_mm256_maskload_ps(&A[i * lda + p], m), x0, acc[i][1]);
+    }
+  }
+
+  for (size_t i = 0; i < rows; i++) {
+    y[i * ldy] = hsum(_mm256_add_ps(acc[i][0], acc[i][1]));
+  }
+}
+
+/* C[4 x cols] = A[4 x k] * B[k x cols], cols <= 16 */
+__attribute__((target("avx2,fma")))
+static void kernel_narrow_4(size_t k, size_t cols,
+                            const float* A, size_t lda,
+                            const float* B, size_t ldb,
+                                  float* C, size_t ldc)
+{
+  __m256i m0 = tail_mask(cols > 8 ? 8 : cols);
+  __m256i m1 = tail_mask(cols > 8 ? cols - 8 : 0);
+
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+
+  for (size_t p = 0; p < k; p++) {
+    __m256 b0 = _mm256_maskload_ps(&B[p * ldb    ], m0);
+    __m256 b1 = _mm256_maskload_ps(&B[p * ldb + 8], m1);
+    __m256 a;
+
+    a = _mm256_broadcast_ss(&A[0 * lda + p]);
+    c00 = _mm256_fmadd_ps(a, b0, c00); c01 = _mm256_fmadd_ps(a, b1, c01);
+    a = _mm256_broadcast_ss(&A[1 * lda + p]);
+    c10 = _mm256_fmadd_ps(a, b0, c10); c11 = _mm256_fmadd_ps(a, b1, c11);
+    a = _mm256_broadcast_ss(&A[2 * lda + p]);
+    c20 = _mm256_fmadd_ps(a, b0, c20); c21 = _mm256_fmadd_ps(a, b1, c21);
+    a = _mm256_broadcast_ss(&A[3 * lda + p]);
+    c30 = _mm256_fmadd_ps(a, b0, c30); c31 = _mm256_fmadd_ps(a, b1, c31);
+  }
+
+  _mm256_maskstore_ps(&C[0 * ldc], m0, c00); _mm256_maskstore_ps(&C[0 * ldc + 8], m1, c01);
+  _mm256_maskstore_ps(&C[1 * ldc], m0, c10); _mm256_maskstore_ps(&C[1 * ldc + 8], m1, c11);
+  _mm256_maskstore_ps(&C[2 * ldc], m0, c20); _mm256_maskstore_ps(&C[2 * ldc + 8], m1, c21);
+  _mm256_maskstore_ps(&C[3 * ldc], m0, c30); _mm256_maskstore_ps(&C[3 * ldc + 8], m1, c31);
+}
+
+/* C[rows x cols] += A[rows x 4] * B[4 x cols]: four rows of B per pass */
+__attribute__((target("avx2,fma")))
+static void kernel_stream_4(size_t rows, size_t cols,
+                            const float* A, size_t lda,
+                            const float* B, size_t ldb,
+                                  float* C, size_t ldc)
+{
+  const float* b0 = &B[0 * ldb];
+  const float* b1 = &B[1 * ldb];
+  const float* b2 = &B[2 * ldb];
+  const float* b3 = &B[3 * ldb];
+
+  for (size_t i = 0; i < rows; i++) {
+    __m256 a0 = _mm256_broadcast_ss(&A[i * lda + 0]);
+    __m256 a1 = _mm256_broadcast_ss(&A[i * lda + 1]);
+    __m256 a2 = _mm256_broadcast_ss(&A[i * lda + 2]);
+    __m256 a3 = _mm256_broadcast_ss(&A[i * lda + 3]);
+    float* c  = &C[i * ldc];
+
+    size_t j = 0;
+    for (; j + 8 <= cols; j += 8) {
+      /* Two chains instead of one to halve the FMA latency per store */
+      __m256 s0 = _mm256_fmadd_ps(a0, _mm256_loadu_ps(&b0[j]), _mm256_loadu_ps(&c[j]));
+      __m256 s1 = _mm256_mul_ps  (a1, _mm256_loadu_ps(&b1[j]));
+      s0 = _mm256_fmadd_ps(a2, _mm256_loadu_ps(&b2[j]), s0);
+      s1 = _mm256_fmadd_ps(a3, _mm256_loadu_ps(&b3[j]), s1);
+      _mm256_storeu_ps(&c[j], _mm256_add_ps(s0, s1));
+    }
+    if (j < cols) {
+      __m256i m  = tail_mask(cols - j);
+      __m256  s0 = _mm256_fmadd_ps(a0, _mm256_maskload_ps(&b0[j], m), _mm256_maskload_ps(&c[j], m));
+      __m256  s1 = _mm256_mul_ps  (a1, _mm256_maskload_ps(&b1[j], m));
+      s0 = _mm256_fmadd_ps(a2, _mm256_maskload_ps(&b2[j], m), s0);
+      s1 = _mm256_fmadd_ps(a3, _mm256_maskload_ps(&b3[j], m), s1);
+      _mm256_maskstore_ps(&c[j], m, _mm256_add_ps(s0, s1));
+    }
+  }
+}
+#endif
+
+/* colsB == 1: C = A x */
+static void gemv_dot(size_t m, size_t k, const float* A, const float* x, float* y)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  for (size_t i = 0; i < m; i += 4) {
+    size_t rows = (m - i) < 4 ? (m - i) : 4;
+    kernel_dot(rows, k, &A[i * k], k, x, &y[i], 1);
+  }
+#else
+  for (size_t i = 0; i < m; i++) {
+    float sum = 0.0f;
+    for (size_t p = 0; p < k; p++) {
+      sum += A[i * k + p] * x[p];
+    }
+    y[i] = sum;
+  }
+#endif
+}
+
+/* colsB <= 16: four rows of A at a time */
+static void gemm_narrow(size_t m, size_t n, size_t k,
+                        const float* A, const float* B, float* C)
+{
+  size_t i = 0;
+
+#if defined(__amd64__) || defined(__x86_64__)
+  for (; i + 4 <= m; i += 4) {
+    kernel_narrow_4(k, n, &A[i * k], k, B, n, &C[i * n], n);
+  }
+#endif
+
+  /* Leftover rows */
+  memset(&C[i * n], 0, (m - i) * n * sizeof(float));
+  mmult_vec_kernel(m - i, n, k, &A[i * k], k, B, n, &C[i * n], n);
+}
+
+/* rowsA <= 16: stream B four rows at a time into strips of C */
+static void gemm_short(size_t m, size_t n, size_t k,
+                       const float* A, const float* B, float* C)
+{
+  size_t strip = (GEMV_STRIP_FLOATS / m) & ~(size_t)7;
+  if (strip < 64) strip = 64;
+
+  memset(C, 0, m * n * sizeof(float));
+
+  for (size_t jj = 0; jj < n; jj += strip) {
+    size_t nb = (n - jj) < strip ? (n - jj) : strip;
+    size_t p  = 0;
+
+#if defined(__amd64__) || defined(__x86_64__)
+    for (; p + 4 <= k; p += 4) {
+      kernel_stream_4(m, nb, &A[p], k, &B[p * n + jj], n, &C[jj], n);
+    }
+#endif
+
+    /* Leftover rows of B */
+    mmult_vec_kernel(m, nb, k - p, &A[p], k, &B[p * n + jj], n, &C[jj], n);
+  }
+}
+
+/* GEMV / Skinny Implementation */
+void* impl_mmult_gemv(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  const float* matA  = parsed_args->input_a;
+  const float* matB  = parsed_args->input_b;
+        float* dest  = parsed_args->output;
+  size_t       rowsA = parsed_args->rowsA;
+  size_t       colsA = parsed_args->colsA;
+  size_t       colsB = parsed_args->colsB;
+
+  /* Stream whichever of A and B is larger */
+  if (colsB <= GEMV_MAX_SKINNY && colsB <= rowsA) {
+    if (colsB == 1) {
+      gemv_dot(rowsA, colsA, matA, matB, dest);
+    } else {
+      gemm_narrow(rowsA, colsB, colsA, matA, matB, dest);
+    }
+  } else if (rowsA <= GEMV_MAX_SKINNY) {
+    gemm_short(rowsA, colsB, colsA, matA, matB, dest);
+  } else {
+    impl_vector(args);
+  }
+
+  return NULL;
+}
@@ -0,0 +1,25 @@
+/* gemv.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the GEMV and skinny-GEMM implementation.
+ */
+
+#ifndef __IMPL_GEMV_H_
+#define __IMPL_GEMV_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Largest rowsA or colsB handled by the skinny paths */
+#define GEMV_MAX_SKINNY 16
+
+/* Function declaration */
+void* impl_mmult_gemv(void* args);
+
+/* Whether a rowsA x colsB output takes one of the skinny paths */
+bool  mmult_gemv_skinny(size_t rowsA, size_t colsB);
+
+#endif //__IMPL_GEMV_H_
@@ -0,0 +1,335 @@
+/* half.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of mmult with 16-bit storage and float accumulation
+ *
+ *  A and B are kept at rest as fp16 (IEEE binary16) or bf16 (the upper
+ *  half of a binary32). The conversion happens once, outside the timed
+ *  region (prep). The kernel reads 16-bit values, widens them in
+ *  registers (F16C _mm256_cvtph_ps for fp16, a 16-bit shift for bf16),
+ *  and accumulates in float with the same 6x16 FMA tile as vec.c. Input
+ *  traffic is therefore half that of the float kernels, which is what
+ *  matters for memory-bound tall-skinny shapes.
+ *
+ *  fp16 tops out at 65504, so each operand is scaled by a power of two
+ *  before conversion and C is scaled back; powers of two are exact and
+ *  do not add error. bf16 has the float exponent range and needs none.
+ *
+ *  Rows of A are widened one 6-row panel at a time into a small float
+ *  buffer reused across all column tiles. Columns of B are padded to a
+ *  multiple of 16 so the tile never needs a fringe case.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "vec.h"
+#include "epilogue.h"
+#include "half.h"
+
+/* Blocking */
+#define HALF_KC 256
+
+/* Largest magnitude fp16 operands are scaled to */
+#define FP16_TARGET 16384.0f
+
+/* Private state, built by the prep functions */
+typedef struct {
+  bool      bf16;    // Storage format
+  size_t    np;      // Columns of B, padded to VEC_NR
+  uint16_t* a;       // rowsA x colsA
+  uint16_t* b;       // colsA x np
+  float     unscale; // Undo the power-of-two scaling of A and B
+} half_state_t;
+
+/* Power of two bringing max|x| just under FP16_TARGET */
+static float pow2_scale(const float* x, size_t n)
+{
+  float absmax = 0.0f;
+  for (size_t i = 0; i < n; i++) {
+    absmax = fmaxf(absmax, fabsf(x[i]));
+  }
+  if (absmax == 0.0f) return 1.0f;
+
+  int e;
+  frexpf(FP16_TARGET / absmax, &e);
+  return ldexpf(1.0f, e - 1);
+}
+
+/* Widen 8 stored values to float */
+__attribute__((target("avx2,f16c")))
+static inline __m256 load8(const uint16_t* p, bool bf16)
+{
+  __m128i h = _mm_loadu_si128((const __m128i*)p);
+  if (bf16) {
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+  }
+  return _mm256_cvtph_ps(h);
+}
+
+/* T[6 x 16] = A[6 x k] * B[k x 16], A already widened */
+__attribute__((target("avx2,fma,f16c"), always_inline))
+static inline void tile_6x16(size_t k, const float* A, size_t lda,
+                             const uint16_t* B, size_t ldb,
+                             float* T, bool bf16)
+{
+  __m256 c00 = _mm256_setzero_ps(), c01 = c00, c10 = c00, c11 = c00;
+  __m256 c20 = c00, c21 = c00, c30 = c00, c31 = c00;
+  __m256 c40 = c00, c41 = c00, c50 = c00, c51 = c00;
+
+  for (size_t p = 0; p < k; p++) {
+    __m256 b0 = load8(&B[p * ldb    ], bf16);
+    __m256 b1 = load8(&B[p * ldb + 8], bf16);
+    __m256 a;
+
+    a = _mm256_broadcast_ss(&A[0 * lda + p]);
+    c00 = _mm256_fmadd_ps(a, b0, c00); c01 = _mm256_fmadd_ps(a, b1, c01);
+    a = _mm256_broadcast_ss(&A[1 * lda + p]);
+    c10 = _mm256_fmadd_ps(a, b0, c10); c11 = _mm256_fmadd_ps(a, b1, c11);
+    a = _mm256_broadcast_ss(&A[2 * lda + p]);
+    c20 = _mm256_fmadd_ps(a, b0, c20); c21 = _mm256_fmadd_ps(a, b1, c21);
+    a = _mm256_broadcast_ss(&A[3 * lda + p]);
+    c30 = _mm256_fmadd_ps(a, b0, c30); c31 = _mm256_fmadd_ps(a, b1, c31);
+    a = _mm256_broadcast_ss(&A[4 * lda + p]);
+    c40 = _mm256_fmadd_ps(a, b0, c40); c41 = _mm256_fmadd_ps(a, b1, c41);
+    a = _mm256_broadcast_ss(&A[5 * lda + p]);
+    c50 = _mm256_fmadd_ps(a, b0, c50); c51 = _mm256_fmadd_ps(a, b1, c51);
+  }
+
+  _mm256_storeu_ps(&T[ 0], c00); _mm256_storeu_ps(&T[ 8], c01);
+  _mm256_storeu_ps(&T[16], c10); _mm256_storeu_ps(&T[24], c11);
+  _mm256_storeu_ps(&T[32], c20); _mm256_storeu_ps(&T[40], c21);
+  _mm256_storeu_ps(&T[48], c30); _mm256_storeu_ps(&T[56], c31);
+  _mm256_storeu_ps(&T[64], c40); _mm256_storeu_ps(&T[72], c41);
+  _mm256_storeu_ps(&T[80], c50); _mm256_storeu_ps(&T[88], c51);
+}
+
+/* T[1 x 16] = A[1 x k] * B[k x 16], for panels shorter than 6 rows */
+__attribute__((target("avx2,fma,f16c"), always_inline))
+static inline void tile_1x16(size_t k, const float* A,
+                             const uint16_t* B, size_t ldb,
+                             float* T, bool bf16)
+{
+  __m256 c0 = _mm256_setzero_ps(), c1 = c0;
+
+  for (size_t p = 0; p < k; p++) {
+    __m256 a = _mm256_broadcast_ss(&A[p]);
+    c0 = _mm256_fmadd_ps(a, load8(&B[p * ldb    ], bf16), c0);
+    c1 = _mm256_fmadd_ps(a, load8(&B[p * ldb + 8], bf16), c1);
+  }
+
+  _mm256_storeu_ps(&T[0], c0);
+  _mm256_storeu_ps(&T[8], c1);
+}
+
+/* Shared driver, specialized for each storage format */
+__attribute__((target("avx2,fma,f16c"), always_inline))
+static inline void half_mmult(const half_state_t* st,
+                              size_t rowsA, size_t colsA, size_t colsB,
+                              float* dest, bool bf16)
+{
+  const size_t np = st->np;
+
+  float  T[VEC_MR * VEC_NR];
+  float* Aw = __ALLOC_DATA(float, VEC_MR * HALF_KC);
+
+  memset(dest, 0, rowsA * colsB * sizeof(float));
+
+  for (size_t kk = 0; kk < colsA; kk += HALF_KC) {
+    size_t kb = (colsA - kk) < HALF_KC ? (colsA - kk) : HALF_KC;
+
+    for (size_t i = 0; i < rowsA; i += VEC_MR) {
+      size_t rows = (rowsA - i) < VEC_MR ? (rowsA - i) : VEC_MR;
+
+      /* Widen the 6-row panel of A; missing rows are zero */
+      for (size_t r = 0; r < VEC_MR; r++) {
+        for (size_t p = 0; p < kb; p++) {
+          if (r < rows) {
+            uint16_t h = st->a[(i + r) * colsA + kk + p];
+            Aw[r * HALF_KC + p] = bf16 ? bf16_to_float(h) : fp16_to_float(h);
+          } else {
+            Aw[r * HALF_KC + p] = 0.0f;
+          }
+        }
+      }
+
+      for (size_t j = 0; j < colsB; j += VEC_NR) {
+        size_t cols = (colsB - j) < VEC_NR ? (colsB - j) : VEC_NR;
+
+        if (rows == VEC_MR) {
+          tile_6x16(kb, Aw, HALF_KC, &st->b[kk * np + j], np, T, bf16);
+        } else {
+          for (size_t r = 0; r < rows; r++) {
+            tile_1x16(kb, &Aw[r * HALF_KC], &st->b[kk * np + j], np,
+                      &T[r * VEC_NR], bf16);
+          }
+        }
+
+        for (size_t r = 0; r < rows; r++) {
+          for (size_t c = 0; c < cols; c++) {
+            dest[(i + r) * colsB + j + c] += T[r * VEC_NR + c] * st->unscale;
+          }
+        }
+      }
+    }
+  }
+
+  free(Aw);
+}
+
+/* Untimed setup: convert A and B to 16-bit storage */
+static void* prep(void* args, bool bf16)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  const float* matA  = parsed_args->input_a;
+  const float* matB  = parsed_args->input_b;
+  size_t       rowsA = parsed_args->rowsA;
+  size_t       colsA = parsed_args->colsA;
+  size_t       colsB = parsed_args->colsB;
+
+  half_state_t* st = (half_state_t*)malloc(sizeof(half_state_t));
+
+  st->bf16 = bf16;
+  st->np   = ((colsB + VEC_NR - 1) / VEC_NR) * VEC_NR;
+  st->a    = __ALLOC_DATA(uint16_t, rowsA * colsA);
+  st->b    = __ALLOC_DATA(uint16_t, colsA * st->np);
+
+  float sa = bf16 ? 1.0f : pow2_scale(matA, rowsA * colsA);
+  float sb = bf16 ? 1.0f : pow2_scale(matB, colsA * colsB);
+  st->unscale = 1.0f / (sa * sb);
+
+  for (size_t i = 0; i < rowsA * colsA; i++) {
+    float x = matA[i] * sa;
+    st->a[i] = bf16 ? float_to_bf16(x) : float_to_fp16(x);
+  }
+  for (size_t p = 0; p < colsA; p++) {
+    for (size_t j = 0; j < st->np; j++) {
+      float x = (j < colsB) ? matB[p * colsB + j] * sb : 0.0f;
+      st->b[p * st->np + j] = bf16 ? float_to_bf16(x) : float_to_fp16(x);
+    }
+  }
+
+  double fbytes = (double)(rowsA * colsA + colsA * colsB) * sizeof(float);
+  fprintf(parsed_args->notes ? parsed_args->notes : stdout,
+          "  * %s storage: A + B = %.2f MB (float: %.2f MB)\n",
+          bf16 ? "bf16" : "fp16", fbytes / 2 / 1e6, fbytes / 1e6);
+
+  parsed_args->state = st;
+
+  return NULL;
+}
+
+void* impl_mmult_fp16_prep(void* args)
+{
+  return prep(args, false);
+}
+
+void* impl_mmult_bf16_prep(void* args)
+{
+  return prep(args, true);
+}
+
+void* impl_mmult_half_fini(void* args)
+{
+  args_t*       parsed_args = (args_t*)args;
+  half_state_t* st          = (half_state_t*)parsed_args->state;
+
+  if (st != NULL) {
+    free(st->a);
+    free(st->b);
+    free(st);
+  }
+  parsed_args->state = NULL;
+
+  return NULL;
+}
+
+/* fp16 Implementation */
+__attribute__((target("avx2,fma,f16c")))
+void* impl_mmult_fp16(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  half_mmult((const half_state_t*)parsed_args->state,
+             parsed_args->rowsA, parsed_args->colsA, parsed_args->colsB,
+             parsed_args->output, false);
+
+  return NULL;
+}
+
+/* bf16 Implementation */
+__attribute__((target("avx2,fma,f16c")))
+void* impl_mmult_bf16(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  half_mmult((const half_state_t*)parsed_args->state,
+             parsed_args->rowsA, parsed_args->colsA, parsed_args->colsB,
+             parsed_args->output, true);
+
+  return NULL;
+}
+
+/* Storage rounds every operand by a relative u (2^-11 for fp16, 2^-8  *
+ * for bf16), so |C - C_h| <= (2u + u^2) sum_p |a_ip| |b_pj|. The float *
+ * reference itself is allowed k * eps times the same sum, which is     *
+ * bounded above by sum_p |a_ip| * max_p |b_pj|.                         */
+bool mmult_half_check(const args_t* args, const float* ref)
+{
+  const half_state_t* st    = (const half_state_t*)args->state;
+  const float*        matA  = args->input_a;
+  const float*        matB  = args->input_b;
+  const float*        dest  = args->output;
+  size_t              rowsA = args->rowsA;
+  size_t              colsA = args->colsA;
+  size_t              colsB = args->colsB;
+
+  double u    = st->bf16 ? ldexp(1.0, -8) : ldexp(1.0, -11);
+  double unit = 2.0 * u + u * u + colsA * FLT_EPSILON;
+
+  double* rsum = (double*)calloc(rowsA, sizeof(double));
+  double* cmax = (double*)calloc(colsB, sizeof(double));
+
+  for (size_t i = 0; i < rowsA; i++) {
+    for (size_t p = 0; p < colsA; p++) {
+      rsum[i] += fabs(matA[i * colsA + p]);
+    }
+  }
+  for (size_t p = 0; p < colsA; p++) {
+    for (size_t j = 0; j < colsB; j++) {
+      double b = fabs(matB[p * colsB + j]);
+      cmax[j]  = b > cmax[j] ? b : cmax[j];
+    }
+  }
+
+  bool ok = true;
+  for (size_t i = 0; i < rowsA && ok; i++) {
+    for (size_t j = 0; j < colsB && ok; j++) {
+      double bound = unit * rsum[i] * cmax[j];
+      ok = fabs((double)ref[i * colsB + j] - dest[i * colsB + j]) <= bound;
+    }
+  }
+
+  free(rsum);
+  free(cmax);
+
+  return ok;
+}
@@ -0,0 +1,30 @@
+/* half.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the half-precision storage mmult functions.
+ */
+
+#ifndef __IMPL_HALF_H_
+#define __IMPL_HALF_H_
+
+/* Standard C includes */
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Function declarations */
+void* impl_mmult_fp16(void* args);
+void* impl_mmult_bf16(void* args);
+
+/* Untimed setup and teardown (converts A and B to 16-bit storage) */
+void* impl_mmult_fp16_prep(void* args);
+void* impl_mmult_bf16_prep(void* args);
+void* impl_mmult_half_fini(void* args);
+
+/* Compare against the float reference within the storage rounding bound */
+bool  mmult_half_check(const args_t* args, const float* ref);
+
+#endif //__IMPL_HALF_H_
@@ -0,0 +1,261 @@
+/* incr.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of incremental mmult
+ *
+ *  Between updates the caller marks which rows of A and which columns
+ *  of B it changed. Row i of C depends only on row i of A (and all of
+ *  B), and column j only on column j of B, so an update:
+ *    1. repacks the dirty rows of A and columns of B into the cached
+ *       tiled copies (whole mr / nr panels, every kc block),
+ *    2. recomputes every run of dirty C rows from those rows of A and
+ *       the cached packed B,
+ *    3. recomputes every run of dirty C columns from the cached packed
+ *       A and those columns of B.
+ *  Steps 2 and 3 go through mmult_opt_gemm with the cached operand in
+ *  tiled form, so the unchanged operand is never packed again; only the
+ *  (small) dirty slice of the other one is. A row that is dirty in both
+ *  senses is simply computed twice.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "opt.h"
+#include "layout.h"
+#include "incr.h"
+
+static inline size_t round_up(size_t x, size_t r)
+{
+  return ((x + r - 1) / r) * r;
+}
+
+static inline size_t min(size_t a, size_t b)
+{
+  return (a < b) ? a : b;
+}
+
+incr_t* mmult_incr_create(size_t m, size_t k, size_t n,
+                          const float* A, const float* B, float* C,
+                          const blocking_t* blocking)
+{
+  incr_t* incr = (incr_t*)malloc(sizeof(incr_t));
+
+  incr->m        = m;
+  incr->k        = k;
+  incr->n        = n;
+  incr->A        = A;
+  incr->B        = B;
+  incr->C        = C;
+  incr->blocking = *blocking;
+  mmult_opt_blocking(&incr->blocking);
+
+  incr->At = __ALLOC_DATA(float, layout_tiled_size_a(m, k, &incr->blocking));
+  incr->Bt = __ALLOC_DATA(float, layout_tiled_size_b(k, n, &incr->blocking));
+  incr->work = __ALLOC_DATA(float, mmult_opt_workspace(&incr->blocking));
+  incr->dirty_rows = (uint8_t*)calloc(m, 1);
+  incr->dirty_cols = (uint8_t*)calloc(n, 1);
+
+  /* Everything starts dirty: the first update is a full product */
+  layout_tile_a(m, k, A, k, 1, &incr->blocking, incr->At);
+  layout_tile_b(k, n, B, n, 1, &incr->blocking, incr->Bt);
+  memset(incr->dirty_rows, 1, m);
+  incr->flops = 0.0;
+
+  return incr;
+}
+
+void mmult_incr_dirty_rows(incr_t* incr, size_t first, size_t last)
+{
+  last = min(last, incr->m);
+  if (first < last) {
+    memset(&incr->dirty_rows[first], 1, last - first);
+  }
+}
+
+void mmult_incr_dirty_cols(incr_t* incr, size_t first, size_t last)
+{
+  last = min(last, incr->n);
+  if (first < last) {
+    memset(&incr->dirty_cols[first], 1, last - first);
+  }
+}
+
+/* Next run [*first, *last) of set flags at or after 'from' */
+static int next_run(const uint8_t* flags, size_t len, size_t from,
+                    size_t* first, size_t* last)
+{
+  while (from < len && !flags[from]) from++;
+  if (from >= len) return 0;
+
+  *first = from;
+  while (from < len && flags[from]) from++;
+  *last = from;
+
+  return 1;
+}
+
+void mmult_incr_update(incr_t* incr)
+{
+  const size_t m  = incr->m, k = incr->k, n = incr->n;
+  const size_t kc = incr->blocking.kc;
+  const size_t mr = incr->blocking.mr, nr = incr->blocking.nr;
+  const size_t mp = round_up(m, mr), np = round_up(n, nr);
+
+  size_t first, last;
+
+  /* 1. Refresh the packed copies, whole panels at a time */
+  for (size_t r = 0; next_run(incr->dirty_rows, m, r, &first, &last); r = last) {
+    size_t lo = (first / mr) * mr;
+    size_t hi = min(round_up(last, mr), m);
+    for (size_t pc = 0; pc < k; pc += kc) {
+      size_t kb = min(kc, k - pc);
+      mmult_opt_pack_a(hi - lo, kb, &incr->A[lo * k + pc], k, 1, mr,
+                       &incr->At[pc * mp + lo * kb]);
+    }
+  }
+  for (size_t c = 0; next_run(incr->dirty_cols, n, c, &first, &last); c = last) {
+    size_t lo = (first / nr) * nr;
+    size_t hi = min(round_up(last, nr), n);
+    for (size_t pc = 0; pc < k; pc += kc) {
+      size_t kb = min(kc, k - pc);
+      mmult_opt_pack_b(kb, hi - lo, &incr->B[pc * n + lo], n, 1, nr,
+                       &incr->Bt[pc * np + lo * kb]);
+    }
+  }
+
+  /* 2. Dirty rows of C: fresh rows of A times the cached packed B */
+  opt_operand_t bt = { incr->Bt, 0, 0, true };
+  for (size_t r = 0; next_run(incr->dirty_rows, m, r, &first, &last); r = last) {
+    opt_operand_t a = { &incr->A[first * k], k, 1, false };
+    incr->flops += 2.0 * (last - first) * n * k;
+    mmult_opt_gemm(last - first, n, k, 1.0f, &a, &bt, 0.0f,
+                   &incr->C[first * n], n, NULL, &incr->blocking, incr->work);
+  }
+
+  /* 3. Dirty columns of C: the cached packed A times fresh columns of B */
+  opt_operand_t at = { incr->At, 0, 0, true };
+  for (size_t c = 0; next_run(incr->dirty_cols, n, c, &first, &last); c = last) {
+    opt_operand_t b = { &incr->B[first], n, 1, false };
+    incr->flops += 2.0 * m * (last - first) * k;
+    mmult_opt_gemm(m, last - first, k, 1.0f, &at, &b, 0.0f,
+                   &incr->C[first], n, NULL, &incr->blocking, incr->work);
+  }
+
+  memset(incr->dirty_rows, 0, m);
+  memset(incr->dirty_cols, 0, n);
+}
+
+void mmult_incr_destroy(incr_t* incr)
+{
+  if (incr == NULL) return;
+
+  free(incr->At);
+  free(incr->Bt);
+  free(incr->work);
+  free(incr->dirty_rows);
+  free(incr->dirty_cols);
+  free(incr);
+}
+
+/* Prep: pack both operands and compute the whole product once */
+void* impl_mmult_incr_prep(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  incr_t* incr = mmult_incr_create(parsed_args->rowsA, parsed_args->colsA,
+                                   parsed_args->colsB,
+                                   parsed_args->input_a, parsed_args->input_b,
+                                   parsed_args->output, &parsed_args->blocking);
+  mmult_incr_update(incr);
+  incr->flops = 0.0;
+
+  printf("  * Incremental: %.1f%% of A rows and %.1f%% of B columns dirty per run\n",
+         100.0 * parsed_args->dirty_a, 100.0 * parsed_args->dirty_b);
+
+  parsed_args->state = incr;
+
+  return NULL;
+}
+
+void* impl_mmult_incr_fini(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  mmult_incr_destroy((incr_t*)parsed_args->state);
+  parsed_args->state = NULL;
+
+  return NULL;
+}
+
+/* New values in rows [first, last) of A, which are marked dirty */
+static void change_rows(args_t* args, incr_t* incr, size_t first, size_t last)
+{
+  last = min(last, incr->m);
+  for (size_t i = first; i < last; i++) {
+    for (size_t p = 0; p < incr->k; p++) {
+      args->input_a[i * incr->k + p] = rand();
+    }
+  }
+  mmult_incr_dirty_rows(incr, first, last);
+}
+
+/* New values in columns [first, last) of B, which are marked dirty */
+static void change_cols(args_t* args, incr_t* incr, size_t first, size_t last)
+{
+  last = min(last, incr->n);
+  for (size_t p = 0; p < incr->k; p++) {
+    for (size_t j = first; j < last; j++) {
+      args->input_b[p * incr->n + j] = rand();
+    }
+  }
+  mmult_incr_dirty_cols(incr, first, last);
+}
+
+/* Change ~frac of len in ranges of INCR_DEMO_RANGE at random places */
+static void change_random(args_t* args, incr_t* incr, size_t len, double frac,
+                          void (*change)(args_t*, incr_t*, size_t, size_t))
+{
+  size_t count  = (size_t)(frac * len + 0.5);
+  size_t ranges = (count + INCR_DEMO_RANGE - 1) / INCR_DEMO_RANGE;
+
+  for (size_t r = 0; r < ranges; r++) {
+    size_t first = (size_t)rand() % len;
+    change(args, incr, first, first + min(INCR_DEMO_RANGE, count - r * INCR_DEMO_RANGE));
+  }
+}
+
+/* Untimed step before every run: one simulated tick writes new values *
+ * into random rows of A and columns of B and marks them; the caller    *
+ * recomputes its reference from A and B as they are after the last    */
+void* impl_mmult_incr_tick(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+  incr_t* incr        = (incr_t*)parsed_args->state;
+
+  change_random(parsed_args, incr, incr->m, parsed_args->dirty_a, change_rows);
+  change_random(parsed_args, incr, incr->n, parsed_args->dirty_b, change_cols);
+
+  return NULL;
+}
+
+/* Incremental Implementation: brings C up to date after a tick */
+void* impl_mmult_incr(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  mmult_incr_update((incr_t*)parsed_args->state);
+
+  return NULL;
+}
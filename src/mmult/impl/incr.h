@@ -0,0 +1,62 @@
+/* incr.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for incremental mmult: C = A * B kept up to date while rows of
+ * A and columns of B change.
+ */
+
+#ifndef __IMPL_INCR_H_
+#define __IMPL_INCR_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdint.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Dirty fractions used when -i incr is given none */
+#define INCR_DEFAULT_DIRTY_A 0.02
+
+/* Rows (columns) per dirty range in the driver's simulated updates */
+#define INCR_DEMO_RANGE 16
+
+/* A tracked product of row-major m x k A, k x n B, and m x n C. A and *
+ * B stay owned by the caller, who edits them in place and marks what  *
+ * changed; both are also cached in packed (tiled) form               */
+typedef struct {
+  size_t       m, k, n;
+  const float* A;
+  const float* B;
+  float*       C;
+  blocking_t   blocking;
+
+  float*       At;         // Packed A (layout_tile_a)
+  float*       Bt;         // Packed B (layout_tile_b)
+  float*       work;       // Packing buffers of the dirty slices
+  uint8_t*     dirty_rows; // m flags
+  uint8_t*     dirty_cols; // n flags
+  double       flops;      // Flops the updates recomputed so far
+} incr_t;
+
+/* Function declaration */
+void* impl_mmult_incr(void* args);
+
+/* Untimed setup and teardown (packs A and B, computes all of C), and *
+ * the untimed tick before every run (changes A and B)                */
+void* impl_mmult_incr_prep(void* args);
+void* impl_mmult_incr_fini(void* args);
+void* impl_mmult_incr_tick(void* args);
+
+/* Incremental API */
+incr_t* mmult_incr_create     (size_t m, size_t k, size_t n,
+                               const float* A, const float* B, float* C,
+                               const blocking_t* blocking);
+void    mmult_incr_dirty_rows (incr_t* incr, size_t first, size_t last);
+void    mmult_incr_dirty_cols (incr_t* incr, size_t first, size_t last);
+void    mmult_incr_update     (incr_t* incr);
+void    mmult_incr_destroy    (incr_t* incr);
+
+#endif //__IMPL_INCR_H_
@@ -0,0 +1,429 @@
+/* int8.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of quantized int8 x int8 -> int32 mmult
+ *
+ *  Both operands are quantized symmetrically to [-127, 127]: A with one
+ *  scale per row, B with one scale per column. B plays the role of the
+ *  weights, so it is quantized and packed once, outside the timed region
+ *  (prep). A plays the role of the activations and is quantized inside
+ *  every call. C is dequantized as C[i][j] = sa[i] * sb[j] * acc[i][j].
+ *
+ *  B is packed as [k/4][n][4]: four consecutive k of one column form a
+ *  32-bit lane, so a vector of B covers 8 (AVX2) or 16 (AVX-512) columns
+ *  and four k each. Broadcasting four bytes of a row of A against it
+ *  yields whole rows of C, with no horizontal reductions.
+ *
+ *  AVX2: _mm256_maddubs_epi16 multiplies unsigned by signed bytes. The
+ *  sign of A is moved onto B (|a| * (sign(a) * b)), and since |a| and
+ *  |b| are <= 127 a pair sum never saturates int16. Pairs are widened to
+ *  int32 with _mm256_madd_epi16.
+ *  AVX-512 VNNI: _mm512_dpbusd_epi32 does not saturate, so A is offset
+ *  to unsigned (a + 128) and the offset is removed with the column sums
+ *  of B: acc = sum (a + 128) * b - 128 * sum b.
+ *
+ *  Rows of A, columns of B, and k are zero-padded to the tile sizes.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "int8.h"
+
+/* Padding of the three dimensions (multiples of both kernels' tiles) */
+#define INT8_MPAD 12
+#define INT8_NPAD 32
+#define INT8_KPAD  4
+
+/* Register tiles */
+#define AVX2_MR  4
+#define AVX2_NR 16
+#define VNNI_MR  6
+#define VNNI_NR 32
+
+/* Private state, built by the prep function */
+typedef struct {
+  size_t   mp, np, kp; // Padded dimensions
+  int8_t*  aq;         // mp x kp, quantized per call
+  int8_t*  bq;         // B packed as [kp / 4][np][4]
+  int32_t* bsum;       // Column sums of the quantized B
+  float*   sa;         // Per-row scales of A
+  float*   sb;         // Per-column scales of B
+  bool     vnni;       // Use the AVX-512 VNNI kernel
+} int8_state_t;
+
+static inline int8_t quantize(float x, float inv_scale)
+{
+  float q = rintf(x * inv_scale);
+  if (q >  127.0f) q =  127.0f;
+  if (q < -127.0f) q = -127.0f;
+  return (int8_t)q;
+}
+
+static inline float scale_of(float absmax)
+{
+  return absmax > 0.0f ? absmax / 127.0f : 1.0f;
+}
+
+/* Four consecutive bytes of A as one 32-bit lane */
+static inline int32_t quad(const int8_t* a)
+{
+  int32_t q;
+  memcpy(&q, a, sizeof(q));
+  return q;
+}
+
+/* Write the valid part of an int32 tile, dequantized */
+static inline void store_tile(const int8_state_t* st, const int32_t* acc,
+                              size_t nr, size_t i, size_t j,
+                              size_t rows, size_t cols,
+                              float* dest, size_t ldc)
+{
+  for (size_t r = 0; r < rows; r++) {
+    for (size_t c = 0; c < cols; c++) {
+      dest[(i + r) * ldc + j + c] =
+                      st->sa[i + r] * st->sb[j + c] * (float)acc[r * nr + c];
+    }
+  }
+}
+
+#if !defined(__amd64__) && !defined(__x86_64__)
+/* Generic tile, used on other ISAs */
+static void kernel_scalar(const int8_state_t* st, size_t i, size_t j,
+                          size_t mr, size_t nr, int32_t* acc)
+{
+  for (size_t r = 0; r < mr; r++) {
+    for (size_t c = 0; c < nr; c++) {
+      int32_t sum = 0;
+      for (size_t p = 0; p < st->kp; p++) {
+        sum += (int32_t)st->aq[(i + r) * st->kp + p] *
+               (int32_t)st->bq[((p / 4) * st->np + j + c) * 4 + (p % 4)];
+      }
+      acc[r * nr + c] = sum;
+    }
+  }
+}
+#endif
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* acc += |a| * (sign(a) * b), summed in groups of four bytes */
+__attribute__((target("avx2")))
+static inline __m256i dot4(__m256i acc, __m256i a, __m256i ua, __m256i b,
+                           __m256i ones)
+{
+  __m256i p16 = _mm256_maddubs_epi16(ua, _mm256_sign_epi8(b, a));
+  return _mm256_add_epi32(acc, _mm256_madd_epi16(p16, ones));
+}
+
+/* acc[4 x 16] = A[i:i+4, :] * B[:, j:j+16] */
+__attribute__((target("avx2")))
+static void kernel_avx2_4x16(const int8_state_t* st, size_t i, size_t j,
+                             int32_t* acc)
+{
+  const __m256i ones = _mm256_set1_epi16(1);
+  const size_t  kp   = st->kp;
+  const int8_t* A    = &st->aq[i * kp];
+  const int8_t* B    = &st->bq[j * 4];
+
+  __m256i c00 = _mm256_setzero_si256(), c01 = c00;
+  __m256i c10 = c00, c11 = c00, c20 = c00, c21 = c00, c30 = c00, c31 = c00;
+
+  for (size_t p = 0; p < kp; p += 4) {
+    __m256i b0 = _mm256_load_si256((const __m256i*)&B[0 ]);
+    __m256i b1 = _mm256_load_si256((const __m256i*)&B[32]);
+    __m256i a, ua;
+
+    a  = _mm256_set1_epi32(quad(&A[0 * kp + p])); ua = _mm256_abs_epi8(a);
+    c00 = dot4(c00, a, ua, b0, ones); c01 = dot4(c01, a, ua, b1, ones);
+    a  = _mm256_set1_epi32(quad(&A[1 * kp + p])); ua = _mm256_abs_epi8(a);
+    c10 = dot4(c10, a, ua, b0, ones); c11 = dot4(c11, a, ua, b1, ones);
+    a  = _mm256_set1_epi32(quad(&A[2 * kp + p])); ua = _mm256_abs_epi8(a);
+    c20 = dot4(c20, a, ua, b0, ones); c21 = dot4(c21, a, ua, b1, ones);
+    a  = _mm256_set1_epi32(quad(&A[3 * kp + p])); ua = _mm256_abs_epi8(a);
+    c30 = dot4(c30, a, ua, b0, ones); c31 = dot4(c31, a, ua, b1, ones);
+
+    B += st->np * 4;
+  }
+
+  _mm256_storeu_si256((__m256i*)&acc[0 * AVX2_NR    ], c00);
+  _mm256_storeu_si256((__m256i*)&acc[0 * AVX2_NR + 8], c01);
+  _mm256_storeu_si256((__m256i*)&acc[1 * AVX2_NR    ], c10);
+  _mm256_storeu_si256((__m256i*)&acc[1 * AVX2_NR + 8], c11);
+  _mm256_storeu_si256((__m256i*)&acc[2 * AVX2_NR    ], c20);
+  _mm256_storeu_si256((__m256i*)&acc[2 * AVX2_NR + 8], c21);
+  _mm256_storeu_si256((__m256i*)&acc[3 * AVX2_NR    ], c30);
+  _mm256_storeu_si256((__m256i*)&acc[3 * AVX2_NR + 8], c31);
+}
+
+/* acc[6 x 32] = A[i:i+6, :] * B[:, j:j+32] */
+__attribute__((target("avx512f,avx512bw,avx512vnni")))
+static void kernel_vnni_6x32(const int8_state_t* st, size_t i, size_t j,
+                             int32_t* acc)
+{
+  const size_t  kp  = st->kp;
+  const int8_t* A   = &st->aq[i * kp];
+  const int8_t* B   = &st->bq[j * 4];
+  const int32_t off = (int32_t)0x80808080;
+
+  __m512i c00 = _mm512_setzero_si512(), c01 = c00;
+  __m512i c10 = c00, c11 = c00, c20 = c00, c21 = c00;
+  __m512i c30 = c00, c31 = c00, c40 = c00, c41 = c00, c50 = c00, c51 = c00;
+
+  for (size_t p = 0; p < kp; p += 4) {
+    __m512i b0 = _mm512_load_si512((const void*)&B[0 ]);
+    __m512i b1 = _mm512_load_si512((const void*)&B[64]);
+    __m512i a;
+
+    /* a ^ 0x80 == a + 128 as an unsigned byte */
+    a = _mm512_set1_epi32(quad(&A[0 * kp + p]) ^ off);
+    c00 = _mm512_dpbusd_epi32(c00, a, b0); c01 = _mm512_dpbusd_epi32(c01, a, b1);
+    a = _mm512_set1_epi32(quad(&A[1 * kp + p]) ^ off);
+    c10 = _mm512_dpbusd_epi32(c10, a, b0); c11 = _mm512_dpbusd_epi32(c11, a, b1);
+    a = _mm512_set1_epi32(quad(&A[2 * kp + p]) ^ off);
+    c20 = _mm512_dpbusd_epi32(c20, a, b0); c21 = _mm512_dpbusd_epi32(c21, a, b1);
+    a = _mm512_set1_epi32(quad(&A[3 * kp + p]) ^ off);
+    c30 = _mm512_dpbusd_epi32(c30, a, b0); c31 = _mm512_dpbusd_epi32(c31, a, b1);
+    a = _mm512_set1_epi32(quad(&A[4 * kp + p]) ^ off);
+    c40 = _mm512_dpbusd_epi32(c40, a, b0); c41 = _mm512_dpbusd_epi32(c41, a, b1);
+    a = _mm512_set1_epi32(quad(&A[5 * kp + p]) ^ off);
+    c50 = _mm512_dpbusd_epi32(c50, a, b0); c51 = _mm512_dpbusd_epi32(c51, a, b1);
+
+    B += st->np * 4;
+  }
+
+  /* Remove the +128 offset of A */
+  __m512i s0 = _mm512_slli_epi32(_mm512_loadu_si512((const void*)&st->bsum[j     ]), 7);
+  __m512i s1 = _mm512_slli_epi32(_mm512_loadu_si512((const void*)&st->bsum[j + 16]), 7);
+
+  _mm512_storeu_si512((void*)&acc[0 * VNNI_NR     ], _mm512_sub_epi32(c00, s0));
+  _mm512_storeu_si512((void*)&acc[0 * VNNI_NR + 16], _mm512_sub_epi32(c01, s1));
+  _mm512_storeu_si512((void*)&acc[1 * VNNI_NR     ], _mm512_sub_epi32(c10, s0));
+  _mm512_storeu_si512((void*)&acc[1 * VNNI_NR + 16], _mm512_sub_epi32(c11, s1));
+  _mm512_storeu_si512((void*)&acc[2 * VNNI_NR     ], _mm512_sub_epi32(c20, s0));
+  _mm512_storeu_si512((void*)&acc[2 * VNNI_NR + 16], _mm512_sub_epi32(c21, s1));
+  _mm512_storeu_si512((void*)&acc[3 * VNNI_NR     ], _mm512_sub_epi32(c30, s0));
+  _mm512_storeu_si512((void*)&acc[3 * VNNI_NR + 16], _mm512_sub_epi32(c31, s1));
+  _mm512_storeu_si512((void*)&acc[4 * VNNI_NR     ], _mm512_sub_epi32(c40, s0));
+  _mm512_storeu_si512((void*)&acc[4 * VNNI_NR + 16], _mm512_sub_epi32(c41, s1));
+  _mm512_storeu_si512((void*)&acc[5 * VNNI_NR     ], _mm512_sub_epi32(c50, s0));
+  _mm512_storeu_si512((void*)&acc[5 * VNNI_NR + 16], _mm512_sub_epi32(c51, s1));
+}
+#endif
+
+/* Untimed setup: quantize and pack B, allocate A's buffers */
+static void* prep(void* args, bool allow_vnni)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  const float* matB  = parsed_args->input_b;
+  size_t       rowsA = parsed_args->rowsA;
+  size_t       colsA = parsed_args->colsA;
+  size_t       colsB = parsed_args->colsB;
+
+  int8_state_t* st = (int8_state_t*)malloc(sizeof(int8_state_t));
+
+  st->mp   = ((rowsA + INT8_MPAD - 1) / INT8_MPAD) * INT8_MPAD;
+  st->np   = ((colsB + INT8_NPAD - 1) / INT8_NPAD) * INT8_NPAD;
+  st->kp   = ((colsA + INT8_KPAD - 1) / INT8_KPAD) * INT8_KPAD;
+  st->aq   = __ALLOC_DATA(int8_t , st->mp * st->kp);
+  st->bq   = __ALLOC_DATA(int8_t , st->kp * st->np);
+  st->bsum = __ALLOC_DATA(int32_t, st->np);
+  st->sa   = __ALLOC_DATA(float  , st->mp);
+  st->sb   = __ALLOC_DATA(float  , st->np);
+
+  memset(st->aq  , 0, st->mp * st->kp);
+  memset(st->bq  , 0, st->kp * st->np);
+  memset(st->bsum, 0, st->np * sizeof(int32_t));
+
+  for (size_t j = 0; j < st->np; j++) {
+    st->sb[j] = 1.0f;
+  }
+  for (size_t i = rowsA; i < st->mp; i++) {
+    st->sa[i] = 1.0f;
+  }
+
+  for (size_t j = 0; j < colsB; j++) {
+    float absmax = 0.0f;
+    for (size_t p = 0; p < colsA; p++) {
+      absmax = fmaxf(absmax, fabsf(matB[p * colsB + j]));
+    }
+    st->sb[j] = scale_of(absmax);
+
+    float inv = 1.0f / st->sb[j];
+    for (size_t p = 0; p < colsA; p++) {
+      int8_t q = quantize(matB[p * colsB + j], inv);
+      st->bq[((p / 4) * st->np + j) * 4 + (p % 4)] = q;
+      st->bsum[j] += q;
+    }
+  }
+
+  st->vnni = false;
+#if defined(__amd64__) || defined(__x86_64__)
+  if (allow_vnni) {
+    __builtin_cpu_init();
+    st->vnni = __builtin_cpu_supports("avx512vnni") &&
+               __builtin_cpu_supports("avx512bw");
+  }
+#endif
+  fprintf(parsed_args->notes ? parsed_args->notes : stdout,
+          "  * int8 kernel: %s\n", st->vnni ? "AVX-512 VNNI" : "AVX2");
+
+  parsed_args->state = st;
+
+  return NULL;
+}
+
+void* impl_mmult_int8_prep(void* args)
+{
+  return prep(args, true);
+}
+
+void* impl_mmult_int8_prep_avx2(void* args)
+{
+  return prep(args, false);
+}
+
+void* impl_mmult_int8_fini(void* args)
+{
+  args_t*       parsed_args = (args_t*)args;
+  int8_state_t* st          = (int8_state_t*)parsed_args->state;
+
+  if (st != NULL) {
+    free(st->aq);
+    free(st->bq);
+    free(st->bsum);
+    free(st->sa);
+    free(st->sb);
+    free(st);
+  }
+  parsed_args->state = NULL;
+
+  return NULL;
+}
+
+/* Quantized Implementation */
+void* impl_mmult_int8(void* args)
+{
+  /* Get the argument struct */
+  args_t*       parsed_args = (args_t*)args;
+  int8_state_t* st          = (int8_state_t*)parsed_args->state;
+
+  /* Get all the arguments */
+  const float* matA  = parsed_args->input_a;
+        float* dest  = parsed_args->output;
+  size_t       rowsA = parsed_args->rowsA;
+  size_t       colsA = parsed_args->colsA;
+  size_t       colsB = parsed_args->colsB;
+  size_t       kp    = st->kp;
+
+  /* Quantize A per row */
+  for (size_t i = 0; i < rowsA; i++) {
+    const float* row    = &matA[i * colsA];
+    float        absmax = 0.0f;
+    for (size_t p = 0; p < colsA; p++) {
+      absmax = fmaxf(absmax, fabsf(row[p]));
+    }
+    st->sa[i] = scale_of(absmax);
+
+    float   inv = 1.0f / st->sa[i];
+    int8_t* q   = &st->aq[i * kp];
+    for (size_t p = 0; p < colsA; p++) {
+      q[p] = quantize(row[p], inv);
+    }
+  }
+
+  /* Integer product and dequantization, tile by tile */
+  size_t mr = AVX2_MR, nr = AVX2_NR;
+  if (st->vnni) {
+    mr = VNNI_MR; nr = VNNI_NR;
+  }
+
+  int32_t acc[VNNI_MR * VNNI_NR];
+
+  for (size_t i = 0; i < rowsA; i += mr) {
+    size_t rows = (rowsA - i) < mr ? (rowsA - i) : mr;
+    for (size_t j = 0; j < colsB; j += nr) {
+      size_t cols = (colsB - j) < nr ? (colsB - j) : nr;
+#if defined(__amd64__) || defined(__x86_64__)
+      if (st->vnni) {
+        kernel_vnni_6x32(st, i, j, acc);
+      } else {
+        kernel_avx2_4x16(st, i, j, acc);
+      }
+#else
+      kernel_scalar(st, i, j, mr, nr, acc);
+#endif
+      store_tile(st, acc, nr, i, j, rows, cols, dest, colsB);
+    }
+  }
+
+  return NULL;
+}
+
+/* |C - C_q| <= sum_p |a_ip| db_j + |b_pj| da_i + da_i db_j, where       *
+ * da_i = sa_i / 2 and db_j = sb_j / 2 are the rounding steps. The float *
+ * reference itself is allowed k * eps * sum_p |a_ip| max_p |b_pj|.      */
+bool mmult_int8_check(const args_t* args, const float* ref)
+{
+  const float* matA  = args->input_a;
+  const float* matB  = args->input_b;
+  const float* dest  = args->output;
+  size_t       rowsA = args->rowsA;
+  size_t       colsA = args->colsA;
+  size_t       colsB = args->colsB;
+
+  double* rsum = (double*)calloc(rowsA, sizeof(double));
+  double* rmax = (double*)calloc(rowsA, sizeof(double));
+  double* csum = (double*)calloc(colsB, sizeof(double));
+  double* cmax = (double*)calloc(colsB, sizeof(double));
+
+  for (size_t i = 0; i < rowsA; i++) {
+    for (size_t p = 0; p < colsA; p++) {
+      double a = fabs(matA[i * colsA + p]);
+      rsum[i] += a;
+      rmax[i]  = a > rmax[i] ? a : rmax[i];
+    }
+  }
+  for (size_t p = 0; p < colsA; p++) {
+    for (size_t j = 0; j < colsB; j++) {
+      double b = fabs(matB[p * colsB + j]);
+      csum[j] += b;
+      cmax[j]  = b > cmax[j] ? b : cmax[j];
+    }
+  }
+
+  bool ok = true;
+  for (size_t i = 0; i < rowsA && ok; i++) {
+    double da = rmax[i] / 127.0 / 2.0;
+    for (size_t j = 0; j < colsB && ok; j++) {
+      double db    = cmax[j] / 127.0 / 2.0;
+      double bound = rsum[i] * db + csum[j] * da + colsA * da * db
+                   + colsA * FLT_EPSILON * rsum[i] * cmax[j];
+      ok = fabs((double)ref[i * colsB + j] - dest[i * colsB + j]) <= bound;
+    }
+  }
+
+  free(rsum);
+  free(rmax);
+  free(csum);
+  free(cmax);
+
+  return ok;
+}
@@ -0,0 +1,29 @@
+/* int8.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the quantized int8 mmult function.
+ */
+
+#ifndef __IMPL_INT8_H_
+#define __IMPL_INT8_H_
+
+/* Standard C includes */
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Function declaration */
+void* impl_mmult_int8(void* args);
+
+/* Untimed setup and teardown (quantizes and transposes B) */
+void* impl_mmult_int8_prep(void* args);
+void* impl_mmult_int8_prep_avx2(void* args);
+void* impl_mmult_int8_fini(void* args);
+
+/* Compare against the float reference within the quantization bound */
+bool  mmult_int8_check(const args_t* args, const float* ref);
+
+#endif //__IMPL_INT8_H_
@@ -0,0 +1,373 @@
+/* jit.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of mmult with JIT-generated microkernels
+ *
+ *  For a given tile (mr <= 6 rows, nr <= 16 columns), depth k, leading
+ *  dimensions, and activation, a small x86-64 emitter writes an AVX2
+ *  kernel into an mmap'd page:
+ *    - the accumulators, B loads, and stores exist only for the rows and
+ *      column vectors of that tile; a partial last vector uses a mask
+ *      baked in as a constant, so there are no fringe branches,
+ *    - every address is a base register plus a constant displacement
+ *      (the leading dimensions are immediates), and the k loop is
+ *      unrolled JIT_KUNROLL times with the remainder fully unrolled,
+ *    - the whole depth is accumulated in registers, and the activation
+ *      is applied just before the single store of C.
+ *  Pages are written, then flipped to read+execute. Kernels are cached
+ *  by their parameters, so a shape pays for generation once; the driver
+ *  generates them in the untimed preparation and reports that time.
+ *
+ *  A fixed shape needs at most four kernels: the full tile and the row,
+ *  column, and corner fringes.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "vec.h"
+#include "jit.h"
+
+/* Cached kernel */
+typedef struct jit_entry {
+  size_t            mr, nr, k, lda, ldb, ldc;
+  activation_t      act;
+  jit_fn_t          fn;
+  void*             code;
+  size_t            bytes;
+  struct jit_entry* next;
+} jit_entry_t;
+
+static jit_entry_t* jit_cache = NULL;
+
+/* Lanes [8 - rem, 16) of this table are a mask of the first rem lanes */
+static const int32_t jit_masks[16] = { -1, -1, -1, -1, -1, -1, -1, -1,
+                                        0,  0,  0,  0,  0,  0,  0,  0 };
+
+#if defined(__amd64__) || defined(__x86_64__)
+
+/* Code buffer */
+typedef struct {
+  uint8_t* buf;
+  size_t   len;
+  size_t   cap;
+} emitter_t;
+
+static void emit8(emitter_t* e, uint8_t b)
+{
+  if (e->len < e->cap) e->buf[e->len] = b;
+  e->len++;
+}
+
+static void emit32(emitter_t* e, uint32_t v)
+{
+  for (int i = 0; i < 4; i++) emit8(e, (uint8_t)(v >> (8 * i)));
+}
+
+/* General-purpose registers */
+enum { RAX = 0, RCX = 1, RDX = 2, RSI = 6, RDI = 7 };
+
+/* Three-byte VEX prefix; map 1 = 0F, 2 = 0F38; pp 0 = none, 1 = 66 */
+static void vex(emitter_t* e, int map, int pp, int reg, int vvvv, int rm_ext)
+{
+  emit8(e, 0xC4);
+  emit8(e, (uint8_t)((((reg >> 3) & 1) ^ 1) << 7 | 1 << 6 | (((rm_ext >> 3) & 1) ^ 1) << 5 | map));
+  emit8(e, (uint8_t)(((~vvvv) & 0xF) << 3 | 1 << 2 | pp));
+}
+
+/* ymm reg, [base + disp32] */
+static void vmem(emitter_t* e, int map, int pp, uint8_t op,
+                 int reg, int vvvv, int base, int32_t disp)
+{
+  vex(e, map, pp, reg, vvvv, 0);
+  emit8(e, op);
+  emit8(e, (uint8_t)(0x80 | (reg & 7) << 3 | base));
+  emit32(e, (uint32_t)disp);
+}
+
+/* ymm reg, ymm vvvv, ymm rm */
+static void vreg(emitter_t* e, int map, int pp, uint8_t op,
+                 int reg, int vvvv, int rm)
+{
+  vex(e, map, pp, reg, vvvv, rm);
+  emit8(e, op);
+  emit8(e, (uint8_t)(0xC0 | (reg & 7) << 3 | (rm & 7)));
+}
+
+#define VMOVUPS_LOAD(e, y, b, d)       vmem(e, 1, 0, 0x10, y, 0, b, d)
+#define VMOVUPS_STORE(e, y, b, d)      vmem(e, 1, 0, 0x11, y, 0, b, d)
+#define VMASKMOVPS_LOAD(e, y, m, b, d) vmem(e, 2, 1, 0x2C, y, m, b, d)
+#define VMASKMOVPS_STORE(e, y, m, b, d) vmem(e, 2, 1, 0x2E, y, m, b, d)
+#define VBROADCASTSS(e, y, b, d)       vmem(e, 2, 1, 0x18, y, 0, b, d)
+#define VFMADD231PS(e, y, s, t)        vreg(e, 2, 1, 0xB8, y, s, t)
+#define VXORPS(e, y, s, t)             vreg(e, 1, 0, 0x57, y, s, t)
+#define VMAXPS(e, y, s, t)             vreg(e, 1, 0, 0x5F, y, s, t)
+
+/* add r64, imm32 */
+static void add_imm(emitter_t* e, int r, int32_t imm)
+{
+  emit8(e, 0x48); emit8(e, 0x81); emit8(e, (uint8_t)(0xC0 | r)); emit32(e, (uint32_t)imm);
+}
+
+/* Register roles: acc(i, v) = ymm(2 i + v), B vectors ymm12/13, *
+ * the broadcast of A ymm14, the column mask ymm15               */
+#define ACC(i, v) (2 * (i) + (v))
+#define YB(v)     (12 + (v))
+#define YA        14
+#define YMASK     15
+
+/* One step of the k loop at offset p from the current A and B rows */
+static void emit_step(emitter_t* e, size_t p, size_t mr, size_t nv, bool masked,
+                      size_t lda, size_t ldb)
+{
+  for (size_t v = 0; v < nv; v++) {
+    int32_t d = (int32_t)((p * ldb + 8 * v) * sizeof(float));
+    if (masked && v == nv - 1) VMASKMOVPS_LOAD(e, YB(v), YMASK, RSI, d);
+    else                       VMOVUPS_LOAD   (e, YB(v), RSI, d);
+  }
+  for (size_t i = 0; i < mr; i++) {
+    VBROADCASTSS(e, YA, RDI, (int32_t)((i * lda + p) * sizeof(float)));
+    for (size_t v = 0; v < nv; v++) {
+      VFMADD231PS(e, ACC(i, v), YA, YB(v));
+    }
+  }
+}
+
+/* Emit the whole kernel; returns its size (only counted if cap is 0) */
+static size_t emit_kernel(uint8_t* buf, size_t cap,
+                          size_t mr, size_t nr, size_t k,
+                          size_t lda, size_t ldb, size_t ldc, activation_t act)
+{
+  emitter_t e = { buf, 0, cap };
+  size_t    nv     = (nr + 7) / 8;
+  bool      masked = (nr % 8) != 0;
+
+  /* Prologue: zero the accumulators, load the mask */
+  for (size_t i = 0; i < mr; i++) {
+    for (size_t v = 0; v < nv; v++) {
+      VXORPS(&e, ACC(i, v), ACC(i, v), ACC(i, v));
+    }
+  }
+  if (masked) {
+    uint64_t addr = (uint64_t)(uintptr_t)&jit_masks[8 - nr % 8];
+    emit8(&e, 0x48); emit8(&e, 0xB8 | RAX);          // mov rax, imm64
+    emit32(&e, (uint32_t)addr); emit32(&e, (uint32_t)(addr >> 32));
+    VMOVUPS_LOAD(&e, YMASK, RAX, 0);
+  }
+
+  /* Unrolled k loop */
+  size_t trips = k / JIT_KUNROLL;
+  if (trips > 0) {
+    emit8(&e, 0x48); emit8(&e, 0xC7); emit8(&e, 0xC0 | RCX);   // mov rcx, imm32
+    emit32(&e, (uint32_t)trips);
+    size_t top = e.len;
+    for (size_t p = 0; p < JIT_KUNROLL; p++) {
+      emit_step(&e, p, mr, nv, masked, lda, ldb);
+    }
+    add_imm(&e, RDI, (int32_t)(JIT_KUNROLL * sizeof(float)));
+    add_imm(&e, RSI, (int32_t)(JIT_KUNROLL * ldb * sizeof(float)));
+    emit8(&e, 0x48); emit8(&e, 0x83); emit8(&e, 0xE8 | RCX); emit8(&e, 1);  // sub rcx, 1
+    emit8(&e, 0x0F); emit8(&e, 0x85);                                       // jnz top
+    emit32(&e, (uint32_t)(int32_t)(top - (e.len + 4)));
+  }
+  for (size_t p = 0; p < k % JIT_KUNROLL; p++) {
+    emit_step(&e, p, mr, nv, masked, lda, ldb);
+  }
+
+  /* Epilogue: activation, then the only store of C */
+  if (act == ACT_RELU) {
+    VXORPS(&e, YA, YA, YA);
+  }
+  for (size_t i = 0; i < mr; i++) {
+    for (size_t v = 0; v < nv; v++) {
+      int32_t d = (int32_t)((i * ldc + 8 * v) * sizeof(float));
+      if (act == ACT_RELU) VMAXPS(&e, ACC(i, v), ACC(i, v), YA);
+      if (masked && v == nv - 1) VMASKMOVPS_STORE(&e, ACC(i, v), YMASK, RDX, d);
+      else                       VMOVUPS_STORE   (&e, ACC(i, v), RDX, d);
+    }
+  }
+
+  emit8(&e, 0xC5); emit8(&e, 0xF8); emit8(&e, 0x77);  // vzeroupper
+  emit8(&e, 0xC3);                                    // ret
+
+  return e.len;
+}
+#endif
+
+jit_fn_t mmult_jit_kernel(size_t mr, size_t nr, size_t k,
+                          size_t lda, size_t ldb, size_t ldc,
+                          activation_t act)
+{
+  for (jit_entry_t* c = jit_cache; c != NULL; c = c->next) {
+    if (c->mr == mr && c->nr == nr && c->k == k && c->lda == lda &&
+        c->ldb == ldb && c->ldc == ldc && c->act == act) {
+      return c->fn;
+    }
+  }
+
+#if defined(__amd64__) || defined(__x86_64__)
+  if (mr == 0 || mr > JIT_MR || nr == 0 || nr > JIT_NR || act == ACT_GELU) {
+    return NULL;
+  }
+
+  /* Size the code, then write it into fresh pages and seal them */
+  size_t len   = emit_kernel(NULL, 0, mr, nr, k, lda, ldb, ldc, act);
+  size_t page  = (size_t)sysconf(_SC_PAGESIZE);
+  size_t bytes = ((len + page - 1) / page) * page;
+
+  void* code = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (code == MAP_FAILED) {
+    return NULL;
+  }
+  emit_kernel((uint8_t*)code, len, mr, nr, k, lda, ldb, ldc, act);
+  if (mprotect(code, bytes, PROT_READ | PROT_EXEC) != 0) {
+    munmap(code, bytes);
+    return NULL;
+  }
+
+  jit_entry_t* c = (jit_entry_t*)malloc(sizeof(jit_entry_t));
+  c->mr    = mr;  c->nr  = nr;  c->k   = k;
+  c->lda   = lda; c->ldb = ldb; c->ldc = ldc;
+  c->act   = act;
+  c->fn    = (jit_fn_t)code;
+  c->code  = code;
+  c->bytes = len;
+  c->next  = jit_cache;
+  jit_cache = c;
+
+  return c->fn;
+#else
+  return NULL;
+#endif
+}
+
+void mmult_jit_clear(void)
+{
+  while (jit_cache != NULL) {
+    jit_entry_t* c = jit_cache;
+    jit_cache = c->next;
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    munmap(c->code, ((c->bytes + page - 1) / page) * page);
+    free(c);
+  }
+}
+
+/* Kernels of the (up to) four tile shapes of an m x n product */
+typedef struct {
+  jit_fn_t full, row_fringe, col_fringe, corner;
+  bool     ok;  // Every kernel the shape needs was generated
+} jit_state_t;
+
+static jit_fn_t tile_kernel(const jit_state_t* st, size_t rows, size_t cols)
+{
+  if (rows == JIT_MR) return (cols == JIT_NR) ? st->full : st->col_fringe;
+  return (cols == JIT_NR) ? st->row_fringe : st->corner;
+}
+
+void* impl_mmult_jit_prep(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  size_t       m   = parsed_args->rowsA;
+  size_t       k   = parsed_args->colsA;
+  size_t       n   = parsed_args->colsB;
+  activation_t act = parsed_args->epilogue.act;
+  size_t       mf  = m % JIT_MR;
+  size_t       nf  = n % JIT_NR;
+
+  struct timespec ts;
+  struct timespec te;
+
+  jit_state_t* st = (jit_state_t*)calloc(1, sizeof(jit_state_t));
+
+  __SET_START_TIME();
+  if (m >= JIT_MR && n >= JIT_NR) st->full       = mmult_jit_kernel(JIT_MR, JIT_NR, k, k, n, n, act);
+  if (mf > 0      && n >= JIT_NR) st->row_fringe = mmult_jit_kernel(mf    , JIT_NR, k, k, n, n, act);
+  if (m >= JIT_MR && nf > 0     ) st->col_fringe = mmult_jit_kernel(JIT_MR, nf    , k, k, n, n, act);
+  if (mf > 0      && nf > 0     ) st->corner     = mmult_jit_kernel(mf    , nf    , k, k, n, n, act);
+  __SET_END_TIME();
+
+  st->ok = (m < JIT_MR || n < JIT_NR || st->full       != NULL) &&
+           (mf == 0    || n < JIT_NR || st->row_fringe != NULL) &&
+           (m < JIT_MR || nf == 0    || st->col_fringe != NULL) &&
+           (mf == 0    || nf == 0    || st->corner     != NULL);
+
+  size_t nkernels = 0, bytes = 0;
+  for (jit_entry_t* c = jit_cache; c != NULL; c = c->next) {
+    nkernels++;
+    bytes += c->bytes;
+  }
+  fprintf(parsed_args->notes ? parsed_args->notes : stdout,
+          "  * JIT: %zu kernel(s), %zu bytes of code, generated in %" PRIu64 " ns\n",
+          nkernels, bytes, (uint64_t)__CALC_RUNTIME());
+
+  parsed_args->state = st;
+
+  return NULL;
+}
+
+void* impl_mmult_jit_fini(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  free(parsed_args->state);
+  parsed_args->state = NULL;
+  mmult_jit_clear();
+
+  return NULL;
+}
+
+/* JIT Implementation */
+void* impl_mmult_jit(void* args)
+{
+  /* Get the argument struct */
+  args_t*      parsed_args = (args_t*)args;
+  jit_state_t* st          = (jit_state_t*)parsed_args->state;
+
+  const float* matA  = parsed_args->input_a;
+  const float* matB  = parsed_args->input_b;
+        float* dest  = parsed_args->output;
+  size_t       rowsA = parsed_args->rowsA;
+  size_t       colsA = parsed_args->colsA;
+  size_t       colsB = parsed_args->colsB;
+
+  /* Without generated code (other ISAs), use the compiled kernels */
+  if (!st->ok) {
+    impl_vector(args);
+    if (parsed_args->epilogue.act == ACT_RELU) {
+      for (size_t e = 0; e < rowsA * colsB; e++) {
+        dest[e] = dest[e] > 0.0f ? dest[e] : 0.0f;
+      }
+    }
+    return NULL;
+  }
+
+  /* Column strips outermost, so a kc x 16 strip of B stays in cache */
+  for (size_t j = 0; j < colsB; j += JIT_NR) {
+    size_t cols = (colsB - j) < JIT_NR ? (colsB - j) : JIT_NR;
+    for (size_t i = 0; i < rowsA; i += JIT_MR) {
+      size_t rows = (rowsA - i) < JIT_MR ? (rowsA - i) : JIT_MR;
+      tile_kernel(st, rows, cols)(&matA[i * colsA], &matB[j], &dest[i * colsB + j]);
+    }
+  }
+
+  return NULL;
+}
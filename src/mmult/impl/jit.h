@@ -0,0 +1,44 @@
+/* jit.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the JIT-compiled (shape-specialized) mmult microkernels.
+ */
+
+#ifndef __IMPL_JIT_H_
+#define __IMPL_JIT_H_
+
+/* Standard C includes */
+#include <stddef.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Register tile of the generated kernels (same as vec) */
+#define JIT_MR  6
+#define JIT_NR 16
+
+/* Iterations of the k loop emitted per loop trip */
+#define JIT_KUNROLL 8
+
+/* A generated kernel: C[mr x nr] = act(A[mr x k] * B[k x nr]) */
+typedef void (*jit_fn_t)(const float* A, const float* B, float* C);
+
+/* Function declaration */
+void* impl_mmult_jit(void* args);
+
+/* Untimed setup and teardown (generates the kernels of the shape) */
+void* impl_mmult_jit_prep(void* args);
+void* impl_mmult_jit_fini(void* args);
+
+/* Kernel for a tile shape, generated on first use and cached; NULL *
+ * where code cannot be generated                                     */
+jit_fn_t mmult_jit_kernel(size_t mr, size_t nr, size_t k,
+                          size_t lda, size_t ldb, size_t ldc,
+                          activation_t act);
+
+/* Release every cached kernel */
+void     mmult_jit_clear(void);
+
+#endif //__IMPL_JIT_H_
@@ -0,0 +1,94 @@
+/* layout.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Converters between operand layouts (see layout.h)
+ *
+ *  Tiling reuses the packing routines of the opt kernel one kc block
+ *  at a time, so the tiled format matches what opt would build per
+ *  call by construction. The row/column-major conversion is a plain
+ *  transpose, blocked so that both the reads and the writes stay
+ *  within a few cache lines per block.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "opt.h"
+#include "layout.h"
+
+/* Transpose block edge */
+#define LAYOUT_TB 32
+
+static inline size_t round_up(size_t x, size_t r)
+{
+  return ((x + r - 1) / r) * r;
+}
+
+size_t layout_tiled_size_a(size_t m, size_t k, const blocking_t* blocking)
+{
+  blocking_t blk = *blocking;
+  mmult_opt_blocking(&blk);
+
+  return round_up(m, blk.mr) * k;
+}
+
+size_t layout_tiled_size_b(size_t k, size_t n, const blocking_t* blocking)
+{
+  blocking_t blk = *blocking;
+  mmult_opt_blocking(&blk);
+
+  return k * round_up(n, blk.nr);
+}
+
+void layout_tile_a(size_t m, size_t k, const float* A, size_t rs, size_t cs,
+                   const blocking_t* blocking, float* At)
+{
+  blocking_t blk = *blocking;
+  mmult_opt_blocking(&blk);
+
+  size_t mp = round_up(m, blk.mr);
+
+  for (size_t pc = 0; pc < k; pc += blk.kc) {
+    size_t kb = (k - pc) < blk.kc ? (k - pc) : blk.kc;
+    mmult_opt_pack_a(m, kb, &A[pc * cs], rs, cs, blk.mr, &At[pc * mp]);
+  }
+}
+
+void layout_tile_b(size_t k, size_t n, const float* B, size_t rs, size_t cs,
+                   const blocking_t* blocking, float* Bt)
+{
+  blocking_t blk = *blocking;
+  mmult_opt_blocking(&blk);
+
+  size_t np = round_up(n, blk.nr);
+
+  for (size_t pc = 0; pc < k; pc += blk.kc) {
+    size_t kb = (k - pc) < blk.kc ? (k - pc) : blk.kc;
+    mmult_opt_pack_b(kb, n, &B[pc * rs], rs, cs, blk.nr, &Bt[pc * np]);
+  }
+}
+
+void layout_transpose(size_t rows, size_t cols, const float* src, size_t lds,
+                      float* dst, size_t ldd)
+{
+  for (size_t ii = 0; ii < rows; ii += LAYOUT_TB) {
+    size_t ie = (ii + LAYOUT_TB) < rows ? (ii + LAYOUT_TB) : rows;
+    for (size_t jj = 0; jj < cols; jj += LAYOUT_TB) {
+      size_t je = (jj + LAYOUT_TB) < cols ? (jj + LAYOUT_TB) : cols;
+      for (size_t i = ii; i < ie; i++) {
+        for (size_t j = jj; j < je; j++) {
+          dst[j * ldd + i] = src[i * lds + j];
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,58 @@
+/* layout.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Operand storage layouts and the converters between them.
+ *
+ * The tiled format stores op(A) (m x k) and op(B) (k x n) exactly as
+ * the opt kernel packs them, so a pre-tiled operand is consumed in
+ * place:
+ *   A: for each kc block of k, ceil(m / mr) panels of mr x kb, each
+ *      panel column-by-column (mr contiguous elements per column)
+ *   B: for each kc block of k, ceil(n / nr) panels of kb x nr, each
+ *      panel row-by-row (nr contiguous elements per row)
+ * Rows (columns) past m (n) are zero-filled. A tiled operand is tied
+ * to the blocking it was built with.
+ */
+
+#ifndef __IMPL_LAYOUT_H_
+#define __IMPL_LAYOUT_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Strides of op(X) (rows x cols) stored with 'layout' and 'ld': element *
+ * (i, p) is X[i * rs + p * cs]. A zero ld means tightly packed.         */
+static inline void layout_strides(layout_t layout, bool trans,
+                                  size_t rows, size_t cols, size_t ld,
+                                  size_t* rs, size_t* cs)
+{
+  bool t = trans != (layout == LAYOUT_COL);
+
+  if (ld == 0) {
+    ld = t ? rows : cols;
+  }
+  *rs = t ? 1  : ld;
+  *cs = t ? ld : 1;
+}
+
+/* Elements in a tiled op(A) (m x k) and op(B) (k x n) */
+size_t layout_tiled_size_a(size_t m, size_t k, const blocking_t* blocking);
+size_t layout_tiled_size_b(size_t k, size_t n, const blocking_t* blocking);
+
+/* Converters; element (i, p) of the source is X[i * rs + p * cs] */
+void   layout_tile_a(size_t m, size_t k, const float* A, size_t rs, size_t cs,
+                     const blocking_t* blocking, float* At);
+void   layout_tile_b(size_t k, size_t n, const float* B, size_t rs, size_t cs,
+                     const blocking_t* blocking, float* Bt);
+
+/* dst (cols x rows, leading dim ldd) = transpose of src (rows x cols) */
+void   layout_transpose(size_t rows, size_t cols, const float* src, size_t lds,
+                        float* dst, size_t ldd);
+
+#endif //__IMPL_LAYOUT_H_
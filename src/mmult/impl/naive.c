@@ -18,6 +18,7 @@
 
 /* Include application-specific headers */
 #include "../include/types.h"
+#include "layout.h"
 
 /* Naive Implementation */
 #pragma GCC push_options
@@ -35,10 +36,18 @@ void* impl_mmult_naive(void* args)
     register size_t colsA = parsed_args->colsA;
     register size_t colsB = parsed_args->colsB;
 
+    /* Strides of op(A) and op(B) from their layouts and transposes */
+    size_t ars, acs, brs, bcs;
+    layout_strides(parsed_args->layout_a, parsed_args->trans_a, rowsA, colsA,
+                   parsed_args->lda, &ars, &acs);
+    layout_strides(parsed_args->layout_b, parsed_args->trans_b, colsA, colsB,
+                   parsed_args->ldb, &brs, &bcs);
+    size_t ldc = parsed_args->ldc ? parsed_args->ldc : colsB;
+
     // Initialize destination matrix
     for (size_t i = 0; i < rowsA; i++) {
         for (size_t j = 0; j < colsB; j++) {
-            dest[i * colsB + j] = 0.0f; // Initialize to zero
+            dest[i * ldc + j] = 0.0f; // Initialize to zero
         }
     }
     
@@ -47,12 +56,12 @@ void* impl_mmult_naive(void* args)
         for (register size_t j = 0; j < colsB; j++) {
             float sum = 0.0f;
             for (register size_t k = 0; k < colsA; k++) {
-                float a_element = matA[i * colsA + k];
-                float b_element = matB[k * colsB + j];
+                float a_element = matA[i * ars + k * acs];
+                float b_element = matB[k * brs + j * bcs];
 
                 sum += a_element * b_element;
             }
-            dest[i * colsB + j] = sum;
+            dest[i * ldc + j] = sum;
         }
     }
     
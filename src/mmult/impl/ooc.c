@@ -0,0 +1,585 @@
+/* ooc.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of out-of-core mmult
+ *
+ *  A, B, and C stay in files; only an mt x nt tile of C and two sets
+ *  of panels (an mt x kt panel of A and a kt x nt panel of B each) are
+ *  in memory, sized so that together they fit in --mem-limit:
+ *
+ *    4 * (mt * nt + 2 * kt * (mt + nt)) <= mem_limit
+ *
+ *  The product walks the C tiles and, within each, the k panels. While
+ *  the current panels are multiplied (by the vec kernel, on -n threads)
+ *  a helper thread preads the next ones into the other set. The kernel
+ *  is also asked to start reading them (posix_fadvise WILLNEED) before
+ *  the compute begins, so the disk works during the compute even when
+ *  the helper thread cannot run alongside it. A finished tile of C is
+ *  written back with pwrite.
+ *
+ *  Reads go through pread rather than mmap so that what this process
+ *  holds never grows past the budget; the page cache may of course keep
+ *  more of the files around, but the kernel reclaims it under pressure.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "vec.h"
+#include "para.h"
+#include "ooc.h"
+
+static inline size_t min(size_t a, size_t b)
+{
+  return (a < b) ? a : b;
+}
+
+static inline uint64_t now_ns(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000ull + t.tv_nsec;
+}
+
+/* pread/pwrite until done; false on an error or a short file */
+static bool pread_full(int fd, void* buf, size_t bytes, off_t offset)
+{
+  char* p = (char*)buf;
+
+  while (bytes > 0) {
+    ssize_t r = pread(fd, p, bytes, offset);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    p += r; bytes -= r; offset += r;
+  }
+
+  return true;
+}
+
+static bool pwrite_full(int fd, const void* buf, size_t bytes, off_t offset)
+{
+  const char* p = (const char*)buf;
+
+  while (bytes > 0) {
+    ssize_t r = pwrite(fd, p, bytes, offset);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    p += r; bytes -= r; offset += r;
+  }
+
+  return true;
+}
+
+/* rows x cols block at (row0, col0) of a file with ld columns, packed */
+static bool read_block(int fd, float* dst, size_t rows, size_t cols,
+                       size_t ld, size_t row0, size_t col0)
+{
+  off_t offset = (off_t)(row0 * ld + col0) * sizeof(float);
+
+  if (cols == ld) return pread_full(fd, dst, rows * cols * sizeof(float), offset);
+
+  for (size_t r = 0; r < rows; r++) {
+    if (!pread_full(fd, &dst[r * cols], cols * sizeof(float),
+                    offset + (off_t)(r * ld) * sizeof(float))) return false;
+  }
+
+  return true;
+}
+
+static bool write_block(int fd, const float* src, size_t rows, size_t cols,
+                        size_t ld, size_t row0, size_t col0)
+{
+  off_t offset = (off_t)(row0 * ld + col0) * sizeof(float);
+
+  if (cols == ld) return pwrite_full(fd, src, rows * cols * sizeof(float), offset);
+
+  for (size_t r = 0; r < rows; r++) {
+    if (!pwrite_full(fd, &src[r * cols], cols * sizeof(float),
+                     offset + (off_t)(r * ld) * sizeof(float))) return false;
+  }
+
+  return true;
+}
+
+/* Ask the kernel to start reading the rows a block spans */
+static void advise_block(int fd, size_t rows, size_t cols, size_t ld,
+                         size_t row0, size_t col0)
+{
+  off_t first = (off_t)(row0 * ld + col0) * sizeof(float);
+  off_t last  = (off_t)((row0 + rows - 1) * ld + col0 + cols) * sizeof(float);
+
+  posix_fadvise(fd, first, last - first, POSIX_FADV_WILLNEED);
+}
+
+/* Tile sizes within the budget: square C tiles, then as deep panels *
+ * as fit; if k runs out first, the spare memory widens the tiles    */
+static bool ooc_tiles(size_t m, size_t k, size_t n, size_t mem_limit,
+                      size_t* mt, size_t* kt, size_t* nt)
+{
+  double budget = (double)(mem_limit / sizeof(float));
+  if (budget < 5.0) return false;
+
+  /* mt = nt = kt = t: 5 t^2 elements */
+  size_t t = (size_t)sqrt(budget / 5.0);
+  if (t >= OOC_TILE_ALIGN) t -= t % OOC_TILE_ALIGN;
+
+  size_t k_tile = min(k, t);
+  if (k_tile < k || t >= m || t >= n) {
+    /* mt = nt = x with the panels k_tile deep: x^2 + 4 k_tile x <= budget */
+    size_t x = (size_t)(sqrt(4.0 * k_tile * k_tile + budget) - 2.0 * k_tile);
+    if (x > t && x >= OOC_TILE_ALIGN) x -= x % OOC_TILE_ALIGN;
+    t = (x > t) ? x : t;
+  }
+
+  *mt = min(m, t);
+  *nt = min(n, t);
+
+  /* Deepest panels the rest of the budget holds */
+  double left  = budget - (double)(*mt) * (*nt);
+  size_t depth = (left > 0.0) ? (size_t)(left / (2.0 * (*mt + *nt))) : 0;
+  if (depth >= OOC_TILE_ALIGN) depth -= depth % OOC_TILE_ALIGN;
+  *kt = min(k, depth);
+
+  return *mt > 0 && *nt > 0 && *kt > 0;
+}
+
+/* One step: the panels for C tile (i0, j0) at depth p0 */
+typedef struct {
+  size_t i0, mb;
+  size_t j0, nb;
+  size_t p0, kb;
+} ooc_step_t;
+
+/* Tiling of the whole product */
+typedef struct {
+  size_t m, k, n;
+  size_t mt, kt, nt;
+  size_t tiles_n;   // C tiles per row of tiles
+  size_t panels;    // k panels per C tile
+} ooc_grid_t;
+
+static void ooc_step(const ooc_grid_t* g, size_t s, ooc_step_t* step)
+{
+  size_t tile = s / g->panels;
+
+  step->i0 = (tile / g->tiles_n) * g->mt;
+  step->j0 = (tile % g->tiles_n) * g->nt;
+  step->p0 = (s % g->panels) * g->kt;
+  step->mb = min(g->mt, g->m - step->i0);
+  step->nb = min(g->nt, g->n - step->j0);
+  step->kb = min(g->kt, g->k - step->p0);
+}
+
+typedef struct {
+  int        fd_a, fd_b;
+  size_t     k, n;
+  ooc_step_t step;
+  float*     A;
+  float*     B;
+  bool       ok;
+} ooc_load_t;
+
+static void* ooc_load(void* args)
+{
+  ooc_load_t* l = (ooc_load_t*)args;
+  ooc_step_t* s = &l->step;
+
+  l->ok = read_block(l->fd_a, l->A, s->mb, s->kb, l->k, s->i0, s->p0) &&
+          read_block(l->fd_b, l->B, s->kb, s->nb, l->n, s->p0, s->j0);
+
+  return NULL;
+}
+
+static void ooc_advise(const ooc_load_t* l)
+{
+  const ooc_step_t* s = &l->step;
+
+  advise_block(l->fd_a, s->mb, s->kb, l->k, s->i0, s->p0);
+  advise_block(l->fd_b, s->kb, s->nb, l->n, s->p0, s->j0);
+}
+
+/* C tile += A panel * B panel, over a range of the tile's rows */
+typedef struct {
+  const float* A;
+  const float* B;
+        float* C;
+  size_t       kb, nb;
+} ooc_compute_t;
+
+static void ooc_rows(void* ctx, size_t first, size_t last)
+{
+  ooc_compute_t* c = (ooc_compute_t*)ctx;
+
+  for (size_t jj = 0; jj < c->nb; jj += VEC_NC) {
+    size_t nc = min(VEC_NC, c->nb - jj);
+    for (size_t kk = 0; kk < c->kb; kk += VEC_KC) {
+      size_t kc = min(VEC_KC, c->kb - kk);
+      for (size_t ii = first; ii < last; ii += VEC_MC) {
+        size_t mc = min(VEC_MC, last - ii);
+        mmult_vec_kernel(mc, nc, kc,
+                         &c->A[ii * c->kb + kk], c->kb,
+                         &c->B[kk * c->nb + jj], c->nb,
+                         &c->C[ii * c->nb + jj], c->nb);
+      }
+    }
+  }
+}
+
+static void* ooc_alloc(size_t bytes)
+{
+  return aligned_alloc(64, ((bytes + 63) / 64) * 64);
+}
+
+bool mmult_ooc(int fd_a, int fd_b, int fd_c,
+               size_t m, size_t k, size_t n, size_t mem_limit,
+               int nthreads, int cpu, ooc_stats_t* stats)
+{
+  uint64_t t_start = now_ns();
+
+  memset(stats, 0, sizeof(*stats));
+
+  size_t mt, kt, nt;
+  if (!ooc_tiles(m, k, n, mem_limit, &mt, &kt, &nt)) {
+    printf("ERROR: --mem-limit of %zu bytes cannot hold a tile.\n", mem_limit);
+    return false;
+  }
+  stats->mt = mt;
+  stats->kt = kt;
+  stats->nt = nt;
+  stats->buffer_bytes = (mt * nt + 2 * kt * (mt + nt)) * sizeof(float);
+
+  if (ftruncate(fd_c, (off_t)(m * n) * sizeof(float)) != 0) {
+    printf("ERROR: Cannot size the C file (%s).\n", strerror(errno));
+    return false;
+  }
+
+  float* C    = (float*)ooc_alloc(mt * nt * sizeof(float));
+  float* A[2] = { (float*)ooc_alloc(mt * kt * sizeof(float)),
+                  (float*)ooc_alloc(mt * kt * sizeof(float)) };
+  float* B[2] = { (float*)ooc_alloc(kt * nt * sizeof(float)),
+                  (float*)ooc_alloc(kt * nt * sizeof(float)) };
+  if (C == NULL || A[0] == NULL || A[1] == NULL || B[0] == NULL || B[1] == NULL) {
+    printf("ERROR: Cannot allocate the out-of-core buffers.\n");
+    free(C); free(A[0]); free(A[1]); free(B[0]); free(B[1]);
+    return false;
+  }
+
+  /* Steps in order: C tiles row by row, k panels within a tile */
+  ooc_grid_t grid = { m, k, n, mt, kt, nt, (n + nt - 1) / nt, (k + kt - 1) / kt };
+  size_t     nsteps = ((m + mt - 1) / mt) * grid.tiles_n * grid.panels;
+
+  ooc_load_t load[2];
+  for (int b = 0; b < 2; b++) {
+    load[b].fd_a = fd_a;
+    load[b].fd_b = fd_b;
+    load[b].k    = k;
+    load[b].n    = n;
+    load[b].A    = A[b];
+    load[b].B    = B[b];
+  }
+
+  /* The first panels are read up front */
+  ooc_step(&grid, 0, &load[0].step);
+  ooc_load(&load[0]);
+
+  bool ok = load[0].ok;
+  for (size_t s = 0; s < nsteps && ok; s++) {
+    int         cur  = s & 1;
+    ooc_step_t* step = &load[cur].step;
+    pthread_t   helper;
+    bool        prefetching = (s + 1 < nsteps);
+
+    /* Prefetch the next panels into the other set */
+    if (prefetching) {
+      ooc_step(&grid, s + 1, &load[cur ^ 1].step);
+      ooc_advise(&load[cur ^ 1]);
+      if (pthread_create(&helper, NULL, ooc_load, &load[cur ^ 1]) != 0) {
+        ooc_load(&load[cur ^ 1]);
+        prefetching = false;
+      }
+    }
+
+    stats->bytes_read += (step->mb + step->nb) * step->kb * sizeof(float);
+
+    /* Multiply the current ones */
+    uint64_t t0 = now_ns();
+    if (step->p0 == 0) memset(C, 0, mt * nt * sizeof(float));
+
+    ooc_compute_t compute = { A[cur], B[cur], C, step->kb, step->nb };
+    mmult_parallel_rows(step->mb, nthreads, cpu, ooc_rows, &compute);
+    uint64_t t1 = now_ns();
+    stats->compute_ns += t1 - t0;
+
+    /* Last panel of the tile: write it back */
+    if (step->p0 + step->kb == k) {
+      ok = write_block(fd_c, C, step->mb, step->nb, n, step->i0, step->j0);
+      if (!ok) printf("ERROR: Cannot write the C file (%s).\n", strerror(errno));
+      stats->bytes_written += step->mb * step->nb * sizeof(float);
+    }
+    uint64_t t2 = now_ns();
+    stats->write_ns += t2 - t1;
+
+    if (prefetching) pthread_join(helper, NULL);
+    stats->wait_ns += now_ns() - t2;
+
+    if (s + 1 < nsteps && !load[cur ^ 1].ok) {
+      printf("ERROR: Cannot read the A or B file.\n");
+      ok = false;
+    }
+  }
+
+  free(C);
+  free(A[0]); free(A[1]);
+  free(B[0]); free(B[1]);
+
+  stats->total_ns = now_ns() - t_start;
+
+  return ok;
+}
+
+static void ooc_report(const ooc_stats_t* stats, size_t m, size_t k, size_t n)
+{
+  double operands = (double)(m * k + k * n) * sizeof(float);
+
+  printf("  * Out-of-core: C tiles of %zu x %zu, panels %zu deep, %.2f MB of buffers\n",
+         stats->mt, stats->nt, stats->kt, stats->buffer_bytes / 1e6);
+  printf("      read %.2f MB (%.2fx A + B), wrote %.2f MB\n",
+         stats->bytes_read / 1e6, stats->bytes_read / operands,
+         stats->bytes_written / 1e6);
+  printf("      compute %.3f s, write %.3f s, waiting on reads %.3f s of %.3f s\n",
+         stats->compute_ns / 1e9, stats->write_ns / 1e9,
+         stats->wait_ns / 1e9, stats->total_ns / 1e9);
+}
+
+/* Driver: the operands go to unlinked temporary files in the working *
+ * directory (not /tmp, which is often memory-backed)                 */
+typedef struct {
+  int         fd_a, fd_b, fd_c;
+  ooc_stats_t stats;
+} ooc_state_t;
+
+static int ooc_temp(const char* name)
+{
+  char path[64];
+  snprintf(path, sizeof(path), "mmult_ooc_%s_XXXXXX", name);
+
+  int fd = mkstemp(path);
+  if (fd >= 0) unlink(path);
+
+  return fd;
+}
+
+void* impl_mmult_ooc_prep(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  size_t m = parsed_args->rowsA;
+  size_t k = parsed_args->colsA;
+  size_t n = parsed_args->colsB;
+
+  ooc_state_t* state = (ooc_state_t*)calloc(1, sizeof(ooc_state_t));
+  state->fd_a = ooc_temp("a");
+  state->fd_b = ooc_temp("b");
+  state->fd_c = ooc_temp("c");
+
+  if (state->fd_a < 0 || state->fd_b < 0 || state->fd_c < 0 ||
+      !pwrite_full(state->fd_a, parsed_args->input_a, m * k * sizeof(float), 0) ||
+      !pwrite_full(state->fd_b, parsed_args->input_b, k * n * sizeof(float), 0)) {
+    printf("ERROR: Cannot write the operand files (%s).\n", strerror(errno));
+    exit(1);
+  }
+
+  printf("  * Out-of-core: operands in files, --mem-limit = %.2f MB\n",
+         parsed_args->mem_limit / 1e6);
+
+  parsed_args->state = state;
+
+  return NULL;
+}
+
+void* impl_mmult_ooc_fini(void* args)
+{
+  args_t*      parsed_args = (args_t*)args;
+  ooc_state_t* state       = (ooc_state_t*)parsed_args->state;
+
+  ooc_report(&state->stats, parsed_args->rowsA, parsed_args->colsA,
+                   parsed_args->colsB);
+
+  close(state->fd_a);
+  close(state->fd_b);
+  close(state->fd_c);
+  free(state);
+  parsed_args->state = NULL;
+
+  return NULL;
+}
+
+/* Out-of-core Implementation: C is produced in its file, then read *
+ * back into the output for the driver's check                      */
+void* impl_mmult_ooc(void* args)
+{
+  /* Get the argument struct */
+  args_t*      parsed_args = (args_t*)args;
+  ooc_state_t* state       = (ooc_state_t*)parsed_args->state;
+
+  size_t m = parsed_args->rowsA;
+  size_t k = parsed_args->colsA;
+  size_t n = parsed_args->colsB;
+
+  if (!mmult_ooc(state->fd_a, state->fd_b, state->fd_c, m, k, n,
+                 parsed_args->mem_limit, parsed_args->nthreads,
+                 parsed_args->cpu, &state->stats) ||
+      !pread_full(state->fd_c, parsed_args->output, m * n * sizeof(float), 0)) {
+    exit(1);
+  }
+
+  return NULL;
+}
+
+/* Open an operand file, writing random data to it (a chunk of rows *
+ * at a time) if it does not exist                                  */
+static int ooc_open_operand(const char* path, size_t rows, size_t cols,
+                            size_t mem_limit)
+{
+  size_t bytes = rows * cols * sizeof(float);
+  int    fd    = open(path, O_RDONLY);
+
+  if (fd < 0 && errno == ENOENT) {
+    fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) return -1;
+
+    printf("  * Generating \"%s\" (%zu x %zu, %.2f MB)\n", path, rows, cols, bytes / 1e6);
+    size_t chunk = mem_limit / (cols * sizeof(float));
+    if (chunk == 0) chunk = 1;
+    if (chunk > rows) chunk = rows;
+
+    float* buf = (float*)ooc_alloc(chunk * cols * sizeof(float));
+    for (size_t r = 0; buf != NULL && r < rows; r += chunk) {
+      size_t nr = min(chunk, rows - r);
+      for (size_t i = 0; i < nr * cols; i++) buf[i] = rand();
+      if (!write_block(fd, buf, nr, cols, cols, r, 0)) { free(buf); buf = NULL; }
+    }
+    if (buf == NULL) { close(fd); return -1; }
+    free(buf);
+
+    return fd;
+  }
+
+  struct stat st;
+  if (fd >= 0 && (fstat(fd, &st) != 0 || (size_t)st.st_size != bytes)) {
+    printf("ERROR: \"%s\" holds %lld bytes; a %zu x %zu matrix takes %zu.\n",
+           path, (long long)st.st_size, rows, cols, bytes);
+    close(fd);
+    errno = EINVAL;
+    return -1;
+  }
+
+  return fd;
+}
+
+/* Recompute a few entries of C from the files, in double */
+#define OOC_SPOT_CHECKS 16
+
+static bool ooc_spot_check(int fd_a, int fd_b, int fd_c,
+                           size_t m, size_t k, size_t n)
+{
+  float* row = (float*)ooc_alloc(k * sizeof(float));
+  double worst = 0.0;
+  bool   ok    = (row != NULL);
+
+  for (int c = 0; c < OOC_SPOT_CHECKS && ok; c++) {
+    size_t i = (size_t)rand() % m;
+    size_t j = (size_t)rand() % n;
+    double dot = 0.0, mag = 0.0;
+    float  got;
+
+    ok = read_block(fd_a, row, 1, k, k, i, 0) &&
+         read_block(fd_c, &got, 1, 1, n, i, j);
+    for (size_t p = 0; p < k && ok; p++) {
+      float b;
+      ok = read_block(fd_b, &b, 1, 1, n, p, j);
+      dot += (double)row[p] * b;
+      mag += fabs((double)row[p] * b);
+    }
+
+    double err = (mag > 0.0) ? fabs(got - dot) / mag : 0.0;
+    if (err > worst) worst = err;
+  }
+  free(row);
+
+  double bound = 2.0 * k * 0x1p-24;
+  printf("  * Spot check of %d entries: worst relative error %.3e (bound %.3e) %s\n",
+         OOC_SPOT_CHECKS, worst, bound, (ok && worst <= bound) ? "ok" : "FAILED");
+
+  return ok && worst <= bound;
+}
+
+bool mmult_ooc_files(const char* path_a, const char* path_b, const char* path_c,
+                     size_t m, size_t k, size_t n, size_t mem_limit,
+                     int nthreads, int cpu)
+{
+  printf("Out-of-core product %zu x %zu x %zu within %.2f MB:\n",
+         m, k, n, mem_limit / 1e6);
+
+  int fd_a = ooc_open_operand(path_a, m, k, mem_limit);
+  int fd_b = ooc_open_operand(path_b, k, n, mem_limit);
+  int fd_c = open(path_c, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_a < 0 || fd_b < 0 || fd_c < 0) {
+    printf("ERROR: Cannot open the operand files (%s).\n", strerror(errno));
+    if (fd_a >= 0) close(fd_a);
+    if (fd_b >= 0) close(fd_b);
+    if (fd_c >= 0) close(fd_c);
+    return false;
+  }
+
+  ooc_stats_t stats;
+  bool ok = mmult_ooc(fd_a, fd_b, fd_c, m, k, n, mem_limit, nthreads, cpu, &stats);
+
+  if (ok) {
+    printf("  * \"%s\" written in %.3f s, %.2f GFLOP/s\n", path_c,
+           stats.total_ns / 1e9, 2.0 * m * k * n / stats.total_ns);
+    ooc_report(&stats, m, k, n);
+    ok = ooc_spot_check(fd_a, fd_b, fd_c, m, k, n);
+  }
+
+  close(fd_a);
+  close(fd_b);
+  close(fd_c);
+
+  return ok;
+}
+
+size_t mmult_ooc_parse_size(const char* str)
+{
+  char*  end;
+  double value = strtod(str, &end);
+
+  if (end == str || value <= 0.0) return 0;
+
+  switch (*end) {
+    case 'k': case 'K': value *= 1024.0;                   end++; break;
+    case 'm': case 'M': value *= 1024.0 * 1024.0;          end++; break;
+    case 'g': case 'G': value *= 1024.0 * 1024.0 * 1024.0; end++; break;
+    default: break;
+  }
+  if (*end == 'B' || *end == 'b') end++;
+
+  return (*end == '\0') ? (size_t)value : 0;
+}
@@ -0,0 +1,58 @@
+/* ooc.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for out-of-core mmult: row-major float operands stored in
+ * files, multiplied tile by tile within a fixed memory budget.
+ */
+
+#ifndef __IMPL_OOC_H_
+#define __IMPL_OOC_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Memory budget used when -i ooc is given no --mem-limit */
+#define OOC_DEFAULT_MEM_LIMIT (64ul << 20)
+
+/* Tiles are multiples of this (in elements) unless a dimension is smaller */
+#define OOC_TILE_ALIGN 64
+
+/* Where the time went, and how much went through the files */
+typedef struct {
+  size_t   mt, kt, nt;        // Tile of C (mt x nt) and panel depth (kt)
+  size_t   buffer_bytes;      // Memory held by the panels and the C tile
+  uint64_t bytes_read;
+  uint64_t bytes_written;
+  uint64_t compute_ns;        // Multiplying panels
+  uint64_t wait_ns;           // Waiting for a panel the prefetch had not finished
+  uint64_t write_ns;          // Writing C tiles back
+  uint64_t total_ns;
+} ooc_stats_t;
+
+/* Function declaration */
+void* impl_mmult_ooc(void* args);
+
+/* Untimed setup and teardown (writes A and B to temporary files) */
+void* impl_mmult_ooc_prep(void* args);
+void* impl_mmult_ooc_fini(void* args);
+
+/* C = A * B for m x k A, k x n B, and m x n C in the files behind the *
+ * descriptors, holding at most mem_limit bytes of them at a time      */
+bool  mmult_ooc(int fd_a, int fd_b, int fd_c,
+                size_t m, size_t k, size_t n, size_t mem_limit,
+                int nthreads, int cpu, ooc_stats_t* stats);
+
+/* Standalone run over named files; A and B are generated (streamed, *
+ * never fully in memory) when missing, and C is spot-checked        */
+bool  mmult_ooc_files(const char* path_a, const char* path_b, const char* path_c,
+                      size_t m, size_t k, size_t n, size_t mem_limit,
+                      int nthreads, int cpu);
+
+/* "512M", "2G", "65536" -> bytes; 0 when malformed */
+size_t mmult_ooc_parse_size(const char* str);
+
+#endif //__IMPL_OOC_H_
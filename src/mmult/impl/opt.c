@@ -4,6 +4,24 @@
  * Date  : 28 Nov. 2024
  *
  *  Implmentation of opt mmult
+ *
+ *  The kernel follows the usual five-loop blocking: a kc x nc panel
+ *  of B and an mc x kc block of A are packed into contiguous buffers,
+ *  and an mr x nr micro-kernel walks the packed buffers. All five
+ *  parameters come from args->blocking (see tune/tune.h), so they can
+ *  be tuned per host instead of being hardcoded. The micro-kernel is
+ *  specialized at compile time for each register tile in
+ *  mmult_opt_tiles, so its accumulators really stay in registers.
+ *
+ *  Transposed and column-major operands are absorbed by packing, which
+ *  reads A and B through a (row, column) stride pair; the micro-kernel
+ *  never sees the difference. Pre-tiled operands (layout.h) are already
+ *  in packed form and are used in place, skipping packing entirely.
+ *
+ *  alpha, beta, and the epilogue are applied by the micro-kernel on its
+ *  accumulator tile: beta on the first kc block, the epilogue on the
+ *  last, so C is read and written once per block and there is no
+ *  separate pass over C.
  */
 
 /* Standard C includes */
@@ -18,15 +36,316 @@
 
 /* Include application-specific headers */
 #include "../include/types.h"
+#include "opt.h"
+#include "epilogue.h"
+#include "layout.h"
 #include <stddef.h> // For size_t
 
 static inline size_t min(size_t a, size_t b) {
     return (a < b) ? a : b;
 }
 
-/* Opt Implementation */
+/* Register tiles the micro-kernel is specialized for */
+const size_t mmult_opt_tiles[OPT_NUM_TILES][2] = {
+  {1, 8}, {2, 4}, {2, 6}, {2, 8}, {3, 4}, {4, 2}, {4, 3}, {4, 4}
+};
+
+/* Fill every zero field of 'blk' with the built-in defaults, and fall *
+ * back to the default register tile when mr x nr is not specialized   */
+void mmult_opt_blocking(blocking_t* blk)
+{
+  if (blk->mc == 0) blk->mc = OPT_DEFAULT_MC;
+  if (blk->kc == 0) blk->kc = OPT_DEFAULT_KC;
+  if (blk->nc == 0) blk->nc = OPT_DEFAULT_NC;
+  if (blk->mr == 0) blk->mr = OPT_DEFAULT_MR;
+  if (blk->nr == 0) blk->nr = OPT_DEFAULT_NR;
+
+  /* Only the specialized register tiles exist */
+  bool supported = false;
+  for (int t = 0; t < OPT_NUM_TILES; t++) {
+    supported = supported || (blk->mr == mmult_opt_tiles[t][0] &&
+                              blk->nr == mmult_opt_tiles[t][1]);
+  }
+  if (!supported) {
+    blk->mr = OPT_DEFAULT_MR;
+    blk->nr = OPT_DEFAULT_NR;
+  }
+
+  /* mc and nc have to be multiples of the register tile */
+  blk->mc = ((blk->mc + blk->mr - 1) / blk->mr) * blk->mr;
+  blk->nc = ((blk->nc + blk->nr - 1) / blk->nr) * blk->nr;
+}
+
 #pragma GCC push_options
 #pragma GCC optimize ("O1")
+/* Pack an mb x kb block of A into row panels of mr rows. Inside a  *
+ * panel, the mr elements of one column are contiguous. Rows past   *
+ * mb are zero-filled so the micro-kernel never needs a fringe case *
+ * Element (i, p) of the block is A[i * rs + p * cs].               */
+void mmult_opt_pack_a(size_t mb, size_t kb, const float* A, size_t rs, size_t cs,
+                      size_t mr, float* Ap)
+{
+  for (size_t ir = 0; ir < mb; ir += mr) {
+    size_t rows = min(mr, mb - ir);
+    for (size_t p = 0; p < kb; p++) {
+      for (size_t i = 0; i < rows; i++) {
+        Ap[i] = A[(ir + i) * rs + p * cs];
+      }
+      for (size_t i = rows; i < mr; i++) {
+        Ap[i] = 0.0f;
+      }
+      Ap += mr;
+    }
+  }
+}
+
+/* Pack a kb x nb panel of B into column panels of nr columns; *
+ * element (p, j) of the panel is B[p * rs + j * cs]            */
+void mmult_opt_pack_b(size_t kb, size_t nb, const float* B, size_t rs, size_t cs,
+                      size_t nr, float* Bp)
+{
+  for (size_t jr = 0; jr < nb; jr += nr) {
+    size_t cols = min(nr, nb - jr);
+    for (size_t p = 0; p < kb; p++) {
+      for (size_t j = 0; j < cols; j++) {
+        Bp[j] = B[p * rs + (jr + j) * cs];
+      }
+      for (size_t j = cols; j < nr; j++) {
+        Bp[j] = 0.0f;
+      }
+      Bp += nr;
+    }
+  }
+}
+
+/* Where a micro-kernel tile sits in the whole product */
+typedef struct {
+  float             alpha;
+  float             beta;   // Only meaningful on the first kc block
+  bool              first;  // First kc block: C = beta * C + alpha * acc
+  const epilogue_t* epi;    // Last kc block only, otherwise NULL
+  size_t            row;    // Top-left corner of the tile in C
+  size_t            col;
+} tile_ctx_t;
+
+/* acc[MR x NR] = Ap[MR x kb] * Bp[kb x NR]. MR and NR are constants *
+ * and the loops over them are fully unrolled, so the MR * NR sums     *
+ * live in registers for the whole kb loop, even at O1                 */
+#define __OPT_TILE(MR, NR)                                                   \
+static void tile_##MR##x##NR(size_t kb, const float* Ap, const float* Bp,    \
+                             float* acc)                                     \
+{                                                                            \
+  float c[MR][NR];                                                           \
+                                                                             \
+  _Pragma("GCC unroll 8")                                                    \
+  for (int i = 0; i < MR; i++) {                                             \
+    _Pragma("GCC unroll 8")                                                  \
+    for (int j = 0; j < NR; j++) c[i][j] = 0.0f;                             \
+  }                                                                          \
+                                                                             \
+  for (size_t p = 0; p < kb; p++) {                                          \
+    _Pragma("GCC unroll 8")                                                  \
+    for (int i = 0; i < MR; i++) {                                           \
+      float a = Ap[i];                                                       \
+      _Pragma("GCC unroll 8")                                                \
+      for (int j = 0; j < NR; j++) c[i][j] += a * Bp[j];                     \
+    }                                                                        \
+    Ap += MR;                                                                \
+    Bp += NR;                                                                \
+  }                                                                          \
+                                                                             \
+  _Pragma("GCC unroll 8")                                                    \
+  for (int i = 0; i < MR; i++) {                                             \
+    _Pragma("GCC unroll 8")                                                  \
+    for (int j = 0; j < NR; j++) acc[i * NR + j] = c[i][j];                  \
+  }                                                                          \
+}
+
+__OPT_TILE(1, 8)
+__OPT_TILE(2, 4)
+__OPT_TILE(2, 6)
+__OPT_TILE(2, 8)
+__OPT_TILE(3, 4)
+__OPT_TILE(4, 2)
+__OPT_TILE(4, 3)
+__OPT_TILE(4, 4)
+
+typedef void (*tile_fn_t)(size_t kb, const float* Ap, const float* Bp, float* acc);
+
+/* Same order as mmult_opt_tiles */
+static const tile_fn_t tile_fns[OPT_NUM_TILES] = {
+  tile_1x8, tile_2x4, tile_2x6, tile_2x8, tile_3x4, tile_4x2, tile_4x3, tile_4x4
+};
+
+static tile_fn_t tile_fn(size_t mr, size_t nr)
+{
+  for (int t = 0; t < OPT_NUM_TILES; t++) {
+    if (mr == mmult_opt_tiles[t][0] && nr == mmult_opt_tiles[t][1]) {
+      return tile_fns[t];
+    }
+  }
+
+  return NULL;
+}
+
+/* C[rows x cols] = alpha * Ap[mr x kb] * Bp[kb x nr] + (beta or 1) * C */
+static void micro_kernel(size_t kb, const float* Ap, const float* Bp,
+                         float* C, size_t ldc, tile_fn_t tile,
+                         size_t nr, size_t rows, size_t cols,
+                         const tile_ctx_t* ctx)
+{
+  float acc[OPT_MR_MAX * OPT_NR_MAX];
+
+  tile(kb, Ap, Bp, acc);
+
+  /* C += A * B, the common case, stays a plain accumulate */
+  if (ctx == NULL) {
+    for (size_t i = 0; i < rows; i++) {
+      for (size_t j = 0; j < cols; j++) {
+        C[i * ldc + j] += acc[i * nr + j];
+      }
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t j = 0; j < cols; j++) {
+      float v = ctx->alpha * acc[i * nr + j];
+
+      /* beta == 0 must not read C (it may hold NaNs) */
+      if (!ctx->first) {
+        v += C[i * ldc + j];
+      } else if (ctx->beta != 0.0f) {
+        v += ctx->beta * C[i * ldc + j];
+      }
+
+      if (ctx->epi != NULL) {
+        /* C points at the tile; the epilogue wants whole-matrix indices */
+        epilogue_store(ctx->epi, v, C - (ctx->row * ldc + ctx->col),
+                       ctx->row + i, ctx->col + j, ldc);
+      } else {
+        C[i * ldc + j] = v;
+      }
+    }
+  }
+}
+
+/* C = epilogue(alpha * op(A) * op(B) + beta * C), op(A) is m x k and *
+ * op(B) is k x n. A NULL epilogue means none, and a conversion        *
+ * epilogue leaves partial sums in C                                    */
+void mmult_opt_gemm(size_t m, size_t n, size_t k, float alpha,
+                    const opt_operand_t* A, const opt_operand_t* B,
+                    float beta, float* C, size_t ldc,
+                    const epilogue_t* epi, const blocking_t* blocking,
+                    float* work)
+{
+  blocking_t blk = *blocking;
+  mmult_opt_blocking(&blk);
+
+  const size_t mc = blk.mc, kc = blk.kc, nc = blk.nc;
+  const size_t mr = blk.mr, nr = blk.nr;
+  const tile_fn_t tile = tile_fn(mr, nr);
+
+  /* (row, column) strides of op(A) and op(B) */
+  const size_t ars = A->rs, acs = A->cs;
+  const size_t brs = B->rs, bcs = B->cs;
+
+  /* Padded extents of the tiled formats */
+  const size_t mp = ((m + mr - 1) / mr) * mr;
+  const size_t np = ((n + nr - 1) / nr) * nr;
+
+  /* Plain C += A * B skips the scaling path of the micro-kernel */
+  bool plain = (alpha == 1.0f && beta == 1.0f && epi == NULL);
+
+  /* Packing buffers: the caller's, or ours for this call */
+  float* own = (work == NULL) ? __ALLOC_DATA(float, mmult_opt_workspace(&blk)) : NULL;
+  float* Ap  = (work == NULL) ? own : work;
+  float* Bp  = Ap + mc * kc;
+
+  for (size_t jc = 0; jc < n; jc += nc) {
+    size_t nb = min(nc, n - jc);
+    for (size_t pc = 0; pc < k; pc += kc) {
+      size_t kb = min(kc, k - pc);
+      const float* Bpc = Bp;
+      if (B->tiled) {
+        Bpc = &B->data[pc * np + jc * kb];
+      } else {
+        mmult_opt_pack_b(kb, nb, &B->data[pc * brs + jc * bcs], brs, bcs, nr, Bp);
+      }
+      for (size_t ic = 0; ic < m; ic += mc) {
+        size_t mb = min(mc, m - ic);
+        const float* Apc = Ap;
+        if (A->tiled) {
+          Apc = &A->data[pc * mp + ic * kb];
+        } else {
+          mmult_opt_pack_a(mb, kb, &A->data[ic * ars + pc * acs], ars, acs, mr, Ap);
+        }
+        for (size_t jr = 0; jr < nb; jr += nr) {
+          for (size_t ir = 0; ir < mb; ir += mr) {
+            tile_ctx_t ctx;
+            ctx.alpha = alpha;
+            ctx.beta  = beta;
+            ctx.first = (pc == 0);
+            ctx.epi   = (pc + kb >= k) ? epi : NULL;
+            ctx.row   = ic + ir;
+            ctx.col   = jc + jr;
+
+            micro_kernel(kb, &Apc[ir * kb], &Bpc[jr * kb],
+                         &C[(ic + ir) * ldc + jc + jr], ldc,
+                         tile, nr, min(mr, mb - ir), min(nr, nb - jr),
+                         plain ? NULL : &ctx);
+          }
+        }
+      }
+    }
+  }
+
+  free(own);
+}
+
+size_t mmult_opt_workspace(const blocking_t* blocking)
+{
+  blocking_t blk = *blocking;
+  mmult_opt_blocking(&blk);
+
+  return blk.mc * blk.kc + blk.kc * blk.nc;
+}
+
+/* C[m x n] += A[m x k] * B[k x n], all operands row-major with *
+ * leading dimensions lda, ldb, and ldc                         */
+void mmult_opt_kernel(size_t m, size_t n, size_t k,
+                      const float* A, size_t lda,
+                      const float* B, size_t ldb,
+                            float* C, size_t ldc,
+                      const blocking_t* blocking, float* work)
+{
+  opt_operand_t a = { A, lda, 1, false };
+  opt_operand_t b = { B, ldb, 1, false };
+
+  mmult_opt_gemm(m, n, k, 1.0f, &a, &b, 1.0f, C, ldc, NULL, blocking, work);
+}
+
+/* Prep: the packing buffers, allocated once for all runs */
+void* impl_mmult_opt_prep(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  parsed_args->state = __ALLOC_DATA(float, mmult_opt_workspace(&parsed_args->blocking));
+
+  return NULL;
+}
+
+void* impl_mmult_opt_fini(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  free(parsed_args->state);
+  parsed_args->state = NULL;
+
+  return NULL;
+}
+
+/* Opt Implementation */
 void* impl_mmult_opt(void* args)
 {
   // Get the argument struct
@@ -40,31 +359,24 @@ void* impl_mmult_opt(void* args)
   size_t colsA = parsed_args->colsA;
   size_t colsB = parsed_args->colsB;
 
-  // Initialize destination matrix
-  for (size_t i = 0; i < rowsA; i++) {
-      for (size_t j = 0; j < colsB; j++) {
-          dest[i * colsB + j] = 0.0f;
-      }
-  }
+  // Operand strides from the transposes, layouts, and leading dimensions
+  opt_operand_t a = { matA, 0, 0, parsed_args->layout_a == LAYOUT_TILED };
+  opt_operand_t b = { matB, 0, 0, parsed_args->layout_b == LAYOUT_TILED };
+  layout_strides(parsed_args->layout_a, parsed_args->trans_a, rowsA, colsA,
+                 parsed_args->lda, &a.rs, &a.cs);
+  layout_strides(parsed_args->layout_b, parsed_args->trans_b, colsA, colsB,
+                 parsed_args->ldb, &b.rs, &b.cs);
+  size_t ldc = parsed_args->ldc ? parsed_args->ldc : colsB;
 
-  // Block size
-  const size_t BLOCK_SIZE = 16;
-
-  for (size_t ii = 0; ii < rowsA; ii += BLOCK_SIZE) {
-      for (size_t jj = 0; jj < colsB; jj += BLOCK_SIZE) {
-          for (size_t kk = 0; kk < colsA; kk += BLOCK_SIZE) {
-              for (size_t i = ii; i < min(ii + BLOCK_SIZE, rowsA); i++) {
-                  for (size_t j = jj; j < min(jj + BLOCK_SIZE, colsB); j++) {
-                      float val = dest[i * colsB + j]; // Start with existing value
-                      for (size_t k = kk; k < min(kk + BLOCK_SIZE, colsA); k++) {
-                          val += matA[i * colsA + k] * matB[k * colsB + j];
-                      }
-                      dest[i * colsB + j] = val; // Write back the accumulated value
-                  }
-              }
-          }
-      }
-  }
+  const epilogue_t* epi = epilogue_is_identity(&parsed_args->epilogue) ?
+                          NULL : &parsed_args->epilogue;
+
+  // Blocked multiplication with the (tuned) blocking parameters; beta = 0
+  // overwrites C without reading it, so there is no separate zeroing pass.
+  // The packing buffers are the prep's, if it ran (NULL allocates them)
+  mmult_opt_gemm(rowsA, colsB, colsA, parsed_args->alpha, &a, &b,
+                 parsed_args->beta, dest, ldc, epi, &parsed_args->blocking,
+                 (float*)parsed_args->state);
 
   return NULL;
 }
@@ -9,7 +9,64 @@
 #ifndef __IMPL_OPT_H_
 #define __IMPL_OPT_H_
 
+/* Standard C includes */
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Register tiles (mr x nr) the micro-kernel is specialized for, and *
+ * their largest dimensions                                           */
+#define OPT_NUM_TILES 8
+#define OPT_MR_MAX    4
+#define OPT_NR_MAX    8
+
+extern const size_t mmult_opt_tiles[OPT_NUM_TILES][2];
+
+/* Built-in blocking, used when no tuning is available */
+#define OPT_DEFAULT_MC 128
+#define OPT_DEFAULT_KC 256
+#define OPT_DEFAULT_NC 2048
+#define OPT_DEFAULT_MR 2
+#define OPT_DEFAULT_NR 6
+
+/* One operand of mmult_opt_gemm: element (i, p) of op(X) is     *
+ * data[i * rs + p * cs], unless it is pre-tiled (see layout.h)   */
+typedef struct {
+  const float* data;
+  size_t       rs;
+  size_t       cs;
+  bool         tiled;
+} opt_operand_t;
+
 /* Function declaration */
 void* impl_mmult_opt(void* args);
 
+/* Untimed setup and teardown (allocates the packing buffers) */
+void* impl_mmult_opt_prep(void* args);
+void* impl_mmult_opt_fini(void* args);
+
+/* Blocked building blocks, shared with other implementations. 'work' *
+ * holds mmult_opt_workspace(blocking) floats of packing buffers, so   *
+ * callers in a loop allocate them once; NULL allocates them per call  */
+void   mmult_opt_blocking(blocking_t* blk);
+size_t mmult_opt_workspace(const blocking_t* blocking);
+void   mmult_opt_kernel(size_t m, size_t n, size_t k,
+                        const float* A, size_t lda,
+                        const float* B, size_t ldb,
+                              float* C, size_t ldc,
+                        const blocking_t* blocking, float* work);
+void   mmult_opt_gemm(size_t m, size_t n, size_t k, float alpha,
+                      const opt_operand_t* A, const opt_operand_t* B,
+                      float beta, float* C, size_t ldc,
+                      const epilogue_t* epi, const blocking_t* blocking,
+                      float* work);
+
+/* Packing of one block, shared with the tiled layout converters */
+void  mmult_opt_pack_a(size_t mb, size_t kb, const float* A, size_t rs, size_t cs,
+                       size_t mr, float* Ap);
+void  mmult_opt_pack_b(size_t kb, size_t nb, const float* B, size_t rs, size_t cs,
+                       size_t nr, float* Bp);
+
 #endif //__IMPL_OPT_H_
@@ -1,13 +1,26 @@
 /* para.c
  *
- * Author:
- * Date  :
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
  *
- *  Description
+ *  Implementation of parallelized mmult
+ *
+ *  Rows of C are split into one contiguous range per thread. Every
+ *  range is independent (it reads all of B and its own rows of A), so
+ *  the threads never synchronize until the final join. Worker i is
+ *  pinned to CPU (cpu + i); the calling thread takes the first range.
+ *
+ *  mmult_parallel_rows is shared by the double and complex variants;
+ *  mmult_parallel_ranges takes precomputed ranges for uneven work.
  */
 
+#define _GNU_SOURCE
+
 /* Standard C includes */
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
 
 /* Include common headers */
 #include "common/macros.h"
@@ -20,9 +33,121 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "vec.h"
+#include "para.h"
+
+/* Rows per VEC_MR so threads get whole register tiles */
+#define PARA_ROW_ALIGN VEC_MR
+
+/* Per-thread work */
+typedef struct {
+  void  (*fn)(void* ctx, size_t first, size_t last);
+  void*   ctx;
+  size_t  first;
+  size_t  last;
+  int     cpu;
+} row_work_t;
+
+static void* row_worker(void* args)
+{
+  row_work_t* w = (row_work_t*)args;
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(w->cpu, &cpuset);
+  int __attribute__((unused)) res = pthread_setaffinity_np(pthread_self(),
+                                                sizeof(cpuset), &cpuset);
+  w->fn(w->ctx, w->first, w->last);
+
+  return NULL;
+}
+
+void mmult_parallel_ranges(const size_t* bounds, int nranges, int cpu,
+                           void (*fn)(void* ctx, size_t first, size_t last),
+                           void* ctx)
+{
+  pthread_t  tid[nranges];
+  row_work_t work[nranges];
+
+  for (int t = 0; t < nranges; t++) {
+    work[t].fn    = fn;
+    work[t].ctx   = ctx;
+    work[t].first = bounds[t];
+    work[t].last  = bounds[t + 1];
+    work[t].cpu   = cpu + t;
+
+    if (t > 0) {
+      int __attribute__((unused)) res = \
+                     pthread_create(&tid[t], NULL, row_worker, (void*)&work[t]);
+    }
+  }
+
+  /* The calling thread takes the first range */
+  fn(ctx, work[0].first, work[0].last);
 
-/* Alternative Implementation */
+  for (int t = 1; t < nranges; t++) {
+    pthread_join(tid[t], NULL);
+  }
+}
+
+void mmult_parallel_rows(size_t rows, int nthreads, int cpu,
+                         void (*fn)(void* ctx, size_t first, size_t last),
+                         void* ctx)
+{
+  /* Whole tiles per thread, and no idle threads */
+  size_t tiles = (rows + PARA_ROW_ALIGN - 1) / PARA_ROW_ALIGN;
+  if (nthreads < 1) nthreads = 1;
+  if ((size_t)nthreads > tiles) nthreads = tiles > 0 ? (int)tiles : 1;
+
+  size_t bounds[nthreads + 1];
+  size_t per_thread = tiles / nthreads;
+  size_t remaining  = tiles % nthreads;
+
+  bounds[0] = 0;
+  for (int t = 0; t < nthreads; t++) {
+    size_t cnt  = (per_thread + ((size_t)t < remaining ? 1 : 0)) * PARA_ROW_ALIGN;
+    bounds[t + 1] = bounds[t] + cnt < rows ? bounds[t] + cnt : rows;
+  }
+
+  mmult_parallel_ranges(bounds, nthreads, cpu, fn, ctx);
+}
+
+/* Rows [first, last) of C, blocked around the SIMD base case */
+static void float_rows(void* ctx, size_t first, size_t last)
+{
+  args_t* parsed_args = (args_t*)ctx;
+
+  const float* matA  = parsed_args->input_a;
+  const float* matB  = parsed_args->input_b;
+        float* dest  = parsed_args->output;
+  size_t       colsA = parsed_args->colsA;
+  size_t       colsB = parsed_args->colsB;
+
+  memset(&dest[first * colsB], 0, (last - first) * colsB * sizeof(float));
+
+  for (size_t jj = 0; jj < colsB; jj += VEC_NC) {
+    size_t nb = (colsB - jj) < VEC_NC ? (colsB - jj) : VEC_NC;
+    for (size_t kk = 0; kk < colsA; kk += VEC_KC) {
+      size_t kb = (colsA - kk) < VEC_KC ? (colsA - kk) : VEC_KC;
+      for (size_t ii = first; ii < last; ii += VEC_MC) {
+        size_t mb = (last - ii) < VEC_MC ? (last - ii) : VEC_MC;
+        mmult_vec_kernel(mb, nb, kb,
+                         &matA[ii * colsA + kk], colsA,
+                         &matB[kk * colsB + jj], colsB,
+                         &dest[ii * colsB + jj], colsB);
+      }
+    }
+  }
+}
+
+/* Parallel Implementation */
 void* impl_parallel(void* args)
 {
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  mmult_parallel_rows(parsed_args->rowsA, parsed_args->nthreads,
+                      parsed_args->cpu, float_rows, parsed_args);
+
   return NULL;
 }
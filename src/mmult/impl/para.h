@@ -9,7 +9,20 @@
 #ifndef __IMPL_PARA_H_
 #define __IMPL_PARA_H_
 
+/* Standard C includes */
+#include <stddef.h>
+
 /* Function declaration */
 void* impl_parallel(void* args);
 
+/* Run fn(ctx, first, last) over disjoint row ranges on pinned threads */
+void  mmult_parallel_rows(size_t rows, int nthreads, int cpu,
+                          void (*fn)(void* ctx, size_t first, size_t last),
+                          void* ctx);
+
+/* Same, over nranges caller-chosen ranges [bounds[t], bounds[t + 1]) */
+void  mmult_parallel_ranges(const size_t* bounds, int nranges, int cpu,
+                            void (*fn)(void* ctx, size_t first, size_t last),
+                            void* ctx);
+
 #endif //__IMPL_PARA_H_
@@ -0,0 +1,173 @@
+/* recursive.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of cache-oblivious recursive mmult
+ *
+ *  The product is split in half along its largest dimension until all
+ *  three fit the fixed SIMD base case. No cache size appears anywhere:
+ *  every level of the hierarchy sees some recursion level whose working
+ *  set fits in it.
+ *
+ *  Splitting M or N yields two halves writing disjoint parts of C, so
+ *  they run as independent tasks while the thread budget allows it.
+ *  The budget is split between the halves, and every spawned task is
+ *  pinned to the first CPU of its share. Splitting K makes both halves
+ *  accumulate into the same C, so they always run one after the other.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* If we are on Darwin, include the compatibility header */
+#if defined(__APPLE__)
+#include "common/mach_pthread_compatibility.h"
+#endif
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "vec.h"
+#include "recursive.h"
+
+/* Largest dimension handed to the base case */
+#define REC_LEAF 64
+
+/* One recursive task */
+typedef struct {
+  size_t       m, n, k;
+  const float* A; size_t lda;
+  const float* B; size_t ldb;
+        float* C; size_t ldc;
+
+  int          cpu;
+  int          nthreads;
+} task_t;
+
+static void recurse(task_t* t);
+
+static void* task_worker(void* args)
+{
+  task_t* t = (task_t*)args;
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(t->cpu, &cpuset);
+  int __attribute__((unused)) res = pthread_setaffinity_np(pthread_self(),
+                                                sizeof(cpuset), &cpuset);
+  recurse(t);
+
+  return NULL;
+}
+
+/* Half of x, rounded to a multiple of 'align' when x is large enough */
+static size_t split(size_t x, size_t align)
+{
+  size_t h = x / 2;
+  if (x >= 4 * align) h = (h / align) * align;
+  return h;
+}
+
+static void recurse(task_t* t)
+{
+  size_t m = t->m, n = t->n, k = t->k;
+
+  /* Base case */
+  if (m <= REC_LEAF && n <= REC_LEAF && k <= REC_LEAF) {
+    mmult_vec_kernel(m, n, k, t->A, t->lda, t->B, t->ldb, t->C, t->ldc);
+    return;
+  }
+
+  task_t lo = *t;
+  task_t hi = *t;
+
+  if (k >= m && k >= n) {
+    /* Split K: same C, run in order */
+    size_t h = split(k, 8);
+    lo.k = h;
+    hi.k = k - h;
+    hi.A = t->A + h;
+    hi.B = t->B + h * t->ldb;
+
+    recurse(&lo);
+    recurse(&hi);
+    return;
+  }
+
+  if (m >= n) {
+    /* Split M: rows of C are disjoint */
+    size_t h = split(m, VEC_MR);
+    lo.m = h;
+    hi.m = m - h;
+    hi.A = t->A + h * t->lda;
+    hi.C = t->C + h * t->ldc;
+  } else {
+    /* Split N: columns of C are disjoint */
+    size_t h = split(n, VEC_NR);
+    lo.n = h;
+    hi.n = n - h;
+    hi.B = t->B + h;
+    hi.C = t->C + h;
+  }
+
+  /* Spawn one half while there are threads to give away */
+  if (t->nthreads > 1) {
+    lo.nthreads = t->nthreads / 2;
+    hi.nthreads = t->nthreads - lo.nthreads;
+    hi.cpu      = t->cpu + lo.nthreads;
+
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, task_worker, (void*)&hi) == 0) {
+      recurse(&lo);
+      pthread_join(tid, NULL);
+      return;
+    }
+
+    /* Could not spawn, keep everything */
+    lo.nthreads = t->nthreads;
+    hi.nthreads = t->nthreads;
+    hi.cpu      = t->cpu;
+  }
+
+  recurse(&lo);
+  recurse(&hi);
+}
+
+/* Recursive Implementation */
+void* impl_mmult_recursive(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  size_t rowsA = parsed_args->rowsA;
+  size_t colsA = parsed_args->colsA;
+  size_t colsB = parsed_args->colsB;
+
+  /* Initialize destination matrix */
+  memset(parsed_args->output, 0, rowsA * colsB * sizeof(float));
+
+  task_t root;
+  root.m   = rowsA;
+  root.n   = colsB;
+  root.k   = colsA;
+  root.A   = parsed_args->input_a; root.lda = colsA;
+  root.B   = parsed_args->input_b; root.ldb = colsB;
+  root.C   = parsed_args->output ; root.ldc = colsB;
+
+  root.cpu      = parsed_args->cpu;
+  root.nthreads = parsed_args->nthreads > 0 ? parsed_args->nthreads : 1;
+
+  recurse(&root);
+
+  return NULL;
+}
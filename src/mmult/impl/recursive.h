@@ -0,0 +1,15 @@
+/* recursive.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the cache-oblivious recursive mmult function.
+ */
+
+#ifndef __IMPL_RECURSIVE_H_
+#define __IMPL_RECURSIVE_H_
+
+/* Function declaration */
+void* impl_mmult_recursive(void* args);
+
+#endif //__IMPL_RECURSIVE_H_
@@ -3,7 +3,14 @@
  * Author: Khaleel Alhaboub
  * Date  : 28 Nov. 2024
  *
- *  Implmentation of Naive mmult for ref
+ *  Implmentation of the reference mmult used for verification
+ *
+ *  Every variant accumulates in double: a product of two floats is exact
+ *  in double, so the float and complex references carry only the (much
+ *  smaller) double summation error and the final rounding. The loops are
+ *  blocked (REF_MB rows of REF_NB double accumulators, swept over REF_KB
+ *  rows of B at a time) and the rows are split across the worker threads,
+ *  which keeps the reference a small fraction of the main run.
  */
 
 /* Standard C includes */
@@ -11,6 +18,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
+#include <stdbool.h>
 
 /* Include common headers */
 #include "common/macros.h"
@@ -18,41 +26,221 @@
 
 /* Include application-specific headers */
 #include "../include/types.h"
+#include "epilogue.h"
+#include "layout.h"
+#include "para.h"
+
+/* Blocking of the reference loops */
+#define REF_MB  16
+#define REF_NB 256
+#define REF_KB 256
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/* Rows [first, last) of C = epilogue(alpha * op(A) * op(B) + beta * C) */
+static void float_rows(void* ctx, size_t first, size_t last)
+{
+    args_t* parsed_args = (args_t*)ctx;
+
+    const float* matA  = parsed_args->input_a;
+    const float* matB  = parsed_args->input_b;
+          float* dest  = parsed_args->output;
+    size_t       rowsA = parsed_args->rowsA;
+    size_t       colsA = parsed_args->colsA;
+    size_t       colsB = parsed_args->colsB;
+
+    double alpha = parsed_args->alpha;
+    double beta  = parsed_args->beta;
+
+    /* (row, column) strides of op(A) and op(B) */
+    size_t ars, acs, brs, bcs;
+    layout_strides(parsed_args->layout_a, parsed_args->trans_a, rowsA, colsA,
+                   parsed_args->lda, &ars, &acs);
+    layout_strides(parsed_args->layout_b, parsed_args->trans_b, colsA, colsB,
+                   parsed_args->ldb, &brs, &bcs);
+    size_t ldc = parsed_args->ldc ? parsed_args->ldc : colsB;
+
+    double* acc = (double*)malloc(REF_MB * REF_NB * sizeof(double));
+
+    for (size_t i0 = first; i0 < last; i0 += REF_MB) {
+        size_t mb = MIN(REF_MB, last - i0);
+        for (size_t j0 = 0; j0 < colsB; j0 += REF_NB) {
+            size_t nb = MIN(REF_NB, colsB - j0);
+
+            memset(acc, 0, REF_MB * REF_NB * sizeof(double));
+            for (size_t k0 = 0; k0 < colsA; k0 += REF_KB) {
+                size_t kb = MIN(REF_KB, colsA - k0);
+                for (size_t i = 0; i < mb; i++) {
+                    double* c = &acc[i * REF_NB];
+                    for (size_t k = k0; k < k0 + kb; k++) {
+                        double       a = matA[(i0 + i) * ars + k * acs];
+                        const float* b = &matB[k * brs + j0 * bcs];
+                        for (size_t j = 0; j < nb; j++) {
+                            c[j] += a * (double)b[j * bcs];
+                        }
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < mb; i++) {
+                for (size_t j = 0; j < nb; j++) {
+                    /* beta == 0 must not read C */
+                    double v = alpha * acc[i * REF_NB + j];
+                    if (beta != 0.0) {
+                        v += beta * dest[(i0 + i) * ldc + j0 + j];
+                    }
+                    epilogue_store(&parsed_args->epilogue, (float)v, dest,
+                                   i0 + i, j0 + j, ldc);
+                }
+            }
+        }
+    }
+
+    free(acc);
+}
 
-/* Reference Implementation */
+/* Reference Implementation:
+ *   C = epilogue(alpha * op(A) * op(B) + beta * C)
+ */
 void* impl_ref(void* args)
 {
     /* Get the argument struct */
     args_t* parsed_args = (args_t*)args;
 
-    /* Get all the arguments */
-    register const float* matA = parsed_args->input_a;
-    register const float* matB = parsed_args->input_b;
-    register float* dest = parsed_args->output;
-    register size_t rowsA = parsed_args->rowsA;
-    register size_t colsA = parsed_args->colsA;
-    register size_t colsB = parsed_args->colsB;
-
-    // Initialize destination matrix
-    for (size_t i = 0; i < rowsA; i++) {
-        for (size_t j = 0; j < colsB; j++) {
-            dest[i * colsB + j] = 0.0f; // Initialize to zero
+    mmult_parallel_rows(parsed_args->rowsA, parsed_args->nthreads,
+                        parsed_args->cpu, float_rows, parsed_args);
+
+    return NULL;
+}
+
+/* Rows [first, last) of the double product */
+static void double_rows(void* ctx, size_t first, size_t last)
+{
+    args_t* parsed_args = (args_t*)ctx;
+
+    const double* matA  = (const double*)parsed_args->input_a;
+    const double* matB  = (const double*)parsed_args->input_b;
+          double* dest  = (double*)parsed_args->output;
+    size_t        colsA = parsed_args->colsA;
+    size_t        colsB = parsed_args->colsB;
+
+    double* acc = (double*)malloc(REF_MB * REF_NB * sizeof(double));
+
+    for (size_t i0 = first; i0 < last; i0 += REF_MB) {
+        size_t mb = MIN(REF_MB, last - i0);
+        for (size_t j0 = 0; j0 < colsB; j0 += REF_NB) {
+            size_t nb = MIN(REF_NB, colsB - j0);
+
+            memset(acc, 0, REF_MB * REF_NB * sizeof(double));
+            for (size_t k0 = 0; k0 < colsA; k0 += REF_KB) {
+                size_t kb = MIN(REF_KB, colsA - k0);
+                for (size_t i = 0; i < mb; i++) {
+                    double* c = &acc[i * REF_NB];
+                    for (size_t k = k0; k < k0 + kb; k++) {
+                        double        a = matA[(i0 + i) * colsA + k];
+                        const double* b = &matB[k * colsB + j0];
+                        for (size_t j = 0; j < nb; j++) {
+                            c[j] += a * b[j];
+                        }
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < mb; i++) {
+                memcpy(&dest[(i0 + i) * colsB + j0], &acc[i * REF_NB],
+                       nb * sizeof(double));
+            }
         }
     }
 
-    /* Naive matrix multiplication */
-    for (register size_t i = 0; i < rowsA; i++) {
-        for (register size_t j = 0; j < colsB; j++) {
-            float sum = 0.0f;
-            for (register size_t k = 0; k < colsA; k++) {
-                float a_element = matA[i * colsA + k];
-                float b_element = matB[k * colsB + j];
+    free(acc);
+}
+
+/* Reference Implementation (double) */
+void* impl_ref_double(void* args)
+{
+    /* Get the argument struct */
+    args_t* parsed_args = (args_t*)args;
+
+    mmult_parallel_rows(parsed_args->rowsA, parsed_args->nthreads,
+                        parsed_args->cpu, double_rows, parsed_args);
+
+    return NULL;
+}
+
+/* Rows [first, last) of the complex product, either layout */
+static void complex_rows(void* ctx, size_t first, size_t last)
+{
+    args_t* parsed_args = (args_t*)ctx;
+
+    const float* matA  = parsed_args->input_a;
+    const float* matB  = parsed_args->input_b;
+          float* dest  = parsed_args->output;
+    size_t       rowsA = parsed_args->rowsA;
+    size_t       colsA = parsed_args->colsA;
+    size_t       colsB = parsed_args->colsB;
+
+    /* Element (i, j) of an r x c matrix lives at re[i * c + j] and
+       im[i * c + j]; 'step' is 2 for interleaved pairs, 1 for planes */
+    bool   split = (parsed_args->dtype == DTYPE_COMPLEX_SPLIT);
+    size_t step  = split ? 1 : 2;
+
+    const float* a_re = matA;
+    const float* a_im = split ? matA + rowsA * colsA : matA + 1;
+    const float* b_re = matB;
+    const float* b_im = split ? matB + colsA * colsB : matB + 1;
+    float*       c_re = dest;
+    float*       c_im = split ? dest + rowsA * colsB : dest + 1;
+
+    double* acc_re = (double*)malloc(REF_MB * REF_NB * sizeof(double));
+    double* acc_im = (double*)malloc(REF_MB * REF_NB * sizeof(double));
+
+    for (size_t i0 = first; i0 < last; i0 += REF_MB) {
+        size_t mb = MIN(REF_MB, last - i0);
+        for (size_t j0 = 0; j0 < colsB; j0 += REF_NB) {
+            size_t nb = MIN(REF_NB, colsB - j0);
+
+            memset(acc_re, 0, REF_MB * REF_NB * sizeof(double));
+            memset(acc_im, 0, REF_MB * REF_NB * sizeof(double));
+            for (size_t k0 = 0; k0 < colsA; k0 += REF_KB) {
+                size_t kb = MIN(REF_KB, colsA - k0);
+                for (size_t i = 0; i < mb; i++) {
+                    double* cr = &acc_re[i * REF_NB];
+                    double* ci = &acc_im[i * REF_NB];
+                    for (size_t k = k0; k < k0 + kb; k++) {
+                        double       ar = a_re[((i0 + i) * colsA + k) * step];
+                        double       ai = a_im[((i0 + i) * colsA + k) * step];
+                        const float* br = &b_re[(k * colsB + j0) * step];
+                        const float* bi = &b_im[(k * colsB + j0) * step];
+                        for (size_t j = 0; j < nb; j++) {
+                            cr[j] += ar * br[j * step] - ai * bi[j * step];
+                            ci[j] += ar * bi[j * step] + ai * br[j * step];
+                        }
+                    }
+                }
+            }
 
-                sum += a_element * b_element;
+            for (size_t i = 0; i < mb; i++) {
+                for (size_t j = 0; j < nb; j++) {
+                    c_re[((i0 + i) * colsB + j0 + j) * step] = (float)acc_re[i * REF_NB + j];
+                    c_im[((i0 + i) * colsB + j0 + j) * step] = (float)acc_im[i * REF_NB + j];
+                }
             }
-            dest[i * colsB + j] += sum;
         }
     }
 
+    free(acc_re);
+    free(acc_im);
+}
+
+/* Reference Implementation (complex float, either layout) */
+void* impl_ref_complex(void* args)
+{
+    /* Get the argument struct */
+    args_t* parsed_args = (args_t*)args;
+
+    mmult_parallel_rows(parsed_args->rowsA, parsed_args->nthreads,
+                        parsed_args->cpu, complex_rows, parsed_args);
+
     return NULL;
 }
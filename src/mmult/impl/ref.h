@@ -11,5 +11,7 @@
 
 /* Function declaration */
 void* impl_ref(void* args);
+void* impl_ref_double(void* args);
+void* impl_ref_complex(void* args);
 
 #endif //__IMPL_REF_H_
@@ -0,0 +1,417 @@
+/* spmm.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of sparse-dense mmult (SpMM), C = A * B with A in CSR
+ *
+ *  Row i of C is a sum of rows of B, one per nonzero A(i, p), scaled by
+ *  it. The kernels therefore vectorize along the dense N dimension:
+ *  a strip of 32 columns of C stays in four registers while the row's
+ *  nonzeros are walked, each one a broadcast and four FMAs against a
+ *  contiguous strip of B. The scalar kernel is the same loop without
+ *  registers. The parallel kernel splits rows so that every thread gets
+ *  the same number of nonzeros rather than the same number of rows,
+ *  which is what keeps power-law matrices balanced.
+ *
+ *  Blocked or sliced formats (BCSR, SELL-C-sigma) pay off when the
+ *  vector lanes run along a sparse row, as in SpMV. Here the lanes run
+ *  along B, so plain CSR already gives full-width contiguous loads.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdbool.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "para.h"
+#include "spmm.h"
+
+/* Columns of C per register strip */
+#define SPMM_STRIP 32
+
+/* Random number in [0, 1) */
+static inline double uniform01(void)
+{
+  return (double)rand() / ((double)RAND_MAX + 1.0);
+}
+
+void spmm_sparsify(float* A, size_t rows, size_t cols,
+                   double density, spmm_structure_t structure)
+{
+  /* Zipf row densities min(1, c / (r + 1)); c is bisected so that the *
+   * capped densities still add up to the requested total              */
+  double zipf = 0.0;
+  if (structure == SPMM_POWERLAW) {
+    double lo = 0.0, hi = (double)rows;
+    for (int it = 0; it < 64; it++) {
+      double c   = 0.5 * (lo + hi);
+      double sum = 0.0;
+      for (size_t r = 0; r < rows; r++) {
+        sum += fmin(1.0, c / (double)(r + 1));
+      }
+      if (sum < density * rows) lo = c; else hi = c;
+    }
+    zipf = hi;
+  }
+
+  /* Band width matching the density, and a random row permutation *
+   * for the Zipf ranks so the long rows are scattered               */
+  double  width = density * cols;
+  size_t* rank  = NULL;
+  if (structure == SPMM_POWERLAW) {
+    rank = (size_t*)malloc(rows * sizeof(size_t));
+    for (size_t r = 0; r < rows; r++) rank[r] = r;
+    for (size_t r = rows; r > 1; r--) {
+      size_t s = (size_t)(uniform01() * r);
+      size_t t = rank[r - 1]; rank[r - 1] = rank[s]; rank[s] = t;
+    }
+  }
+
+  for (size_t i = 0; i < rows; i++) {
+    float* row = &A[i * cols];
+
+    if (structure == SPMM_BANDED) {
+      double center = (i + 0.5) * cols / rows;
+      double lo     = center - width / 2.0;
+      double hi     = center + width / 2.0;
+      for (size_t j = 0; j < cols; j++) {
+        if (j + 0.5 < lo || j + 0.5 >= hi) row[j] = 0.0f;
+      }
+      continue;
+    }
+
+    double p = density;
+    if (structure == SPMM_POWERLAW) {
+      p = fmin(1.0, zipf / (double)(rank[i] + 1));
+    }
+    for (size_t j = 0; j < cols; j++) {
+      if (uniform01() >= p) row[j] = 0.0f;
+    }
+  }
+
+  free(rank);
+}
+
+/* Build the CSR form of the dense rows x cols matrix A */
+static csr_t* csr_from_dense(const float* A, size_t rows, size_t cols)
+{
+  csr_t* csr = (csr_t*)malloc(sizeof(csr_t));
+
+  size_t nnz = 0;
+  for (size_t e = 0; e < rows * cols; e++) {
+    nnz += (A[e] != 0.0f);
+  }
+
+  csr->rows   = rows;
+  csr->cols   = cols;
+  csr->nnz    = nnz;
+  csr->rowptr = (size_t*  )malloc((rows + 1) * sizeof(size_t));
+  csr->colidx = (uint32_t*)malloc((nnz > 0 ? nnz : 1) * sizeof(uint32_t));
+  csr->vals   = (float*   )malloc((nnz > 0 ? nnz : 1) * sizeof(float));
+
+  size_t z = 0;
+  for (size_t i = 0; i < rows; i++) {
+    csr->rowptr[i] = z;
+    for (size_t j = 0; j < cols; j++) {
+      if (A[i * cols + j] != 0.0f) {
+        csr->colidx[z] = (uint32_t)j;
+        csr->vals  [z] = A[i * cols + j];
+        z++;
+      }
+    }
+  }
+  csr->rowptr[rows] = z;
+
+  return csr;
+}
+
+static void csr_free(csr_t* csr)
+{
+  if (csr == NULL) return;
+  free(csr->rowptr);
+  free(csr->colidx);
+  free(csr->vals);
+  free(csr);
+}
+
+/* Prep: A is stored dense (with zeros) and converted once, untimed */
+void* impl_spmm_prep(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  parsed_args->state = csr_from_dense(parsed_args->input_a,
+                                      parsed_args->rowsA, parsed_args->colsA);
+
+  csr_t* csr = (csr_t*)parsed_args->state;
+  printf("  * CSR: %zu nonzeros (density %.4f), %.1f MB vs. %.1f MB dense\n",
+         csr->nnz, (double)csr->nnz / (csr->rows * csr->cols),
+         (csr->nnz * (sizeof(float) + sizeof(uint32_t)) +
+          (csr->rows + 1) * sizeof(size_t)) / 1e6,
+         csr->rows * csr->cols * sizeof(float) / 1e6);
+
+  return NULL;
+}
+
+void* impl_spmm_fini(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  csr_free((csr_t*)parsed_args->state);
+  parsed_args->state = NULL;
+
+  return NULL;
+}
+
+/* Rows [first, last) of C, scalar */
+#pragma GCC push_options
+#pragma GCC optimize ("O1")
+static void spmm_rows_scalar(const csr_t* A, const float* B, float* C,
+                             size_t n, size_t first, size_t last)
+{
+  for (size_t i = first; i < last; i++) {
+    float* c = &C[i * n];
+
+    for (size_t j = 0; j < n; j++) {
+      c[j] = 0.0f;
+    }
+
+    for (size_t z = A->rowptr[i]; z < A->rowptr[i + 1]; z++) {
+      float        a = A->vals[z];
+      const float* b = &B[(size_t)A->colidx[z] * n];
+      for (size_t j = 0; j < n; j++) {
+        c[j] += a * b[j];
+      }
+    }
+  }
+}
+#pragma GCC pop_options
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Lane mask with the first 'cols' lanes (0..8) active */
+static inline __m256i tail_mask(size_t cols)
+{
+  const __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)cols), idx);
+}
+
+/* Rows [first, last) of C, one 32-column register strip at a time */
+__attribute__((target("avx2,fma")))
+static void spmm_rows_vec(const csr_t* A, const float* B, float* C,
+                          size_t n, size_t first, size_t last)
+{
+  for (size_t i = first; i < last; i++) {
+    size_t z0 = A->rowptr[i];
+    size_t z1 = A->rowptr[i + 1];
+
+    size_t j = 0;
+    for (; j + SPMM_STRIP <= n; j += SPMM_STRIP) {
+      __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+      __m256 c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+
+      for (size_t z = z0; z < z1; z++) {
+        __m256       a = _mm256_broadcast_ss(&A->vals[z]);
+        const float* b = &B[(size_t)A->colidx[z] * n + j];
+        c0 = _mm256_fmadd_ps(a, _mm256_loadu_ps(&b[ 0]), c0);
+        c1 = _mm256_fmadd_ps(a, _mm256_loadu_ps(&b[ 8]), c1);
+        c2 = _mm256_fmadd_ps(a, _mm256_loadu_ps(&b[16]), c2);
+        c3 = _mm256_fmadd_ps(a, _mm256_loadu_ps(&b[24]), c3);
+      }
+
+      float* c = &C[i * n + j];
+      _mm256_storeu_ps(&c[ 0], c0);
+      _mm256_storeu_ps(&c[ 8], c1);
+      _mm256_storeu_ps(&c[16], c2);
+      _mm256_storeu_ps(&c[24], c3);
+    }
+
+    /* Last partial strip, eight columns at a time */
+    for (; j < n; j += 8) {
+      __m256i m = tail_mask((n - j) < 8 ? (n - j) : 8);
+      __m256  c = _mm256_setzero_ps();
+
+      for (size_t z = z0; z < z1; z++) {
+        __m256 a = _mm256_broadcast_ss(&A->vals[z]);
+        c = _mm256_fmadd_ps(a, _mm256_maskload_ps(&B[(size_t)A->colidx[z] * n + j], m), c);
+      }
+
+      _mm256_maskstore_ps(&C[i * n + j], m, c);
+    }
+  }
+}
+#endif
+
+/* Naive (scalar) Implementation */
+void* impl_spmm_naive(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  const csr_t* A = (const csr_t*)parsed_args->state;
+  spmm_rows_scalar(A, parsed_args->input_b, parsed_args->output,
+                   parsed_args->colsB, 0, A->rows);
+
+  return NULL;
+}
+
+/* Vectorized Implementation */
+void* impl_spmm_vec(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  const csr_t* A = (const csr_t*)parsed_args->state;
+#if defined(__amd64__) || defined(__x86_64__)
+  spmm_rows_vec(A, parsed_args->input_b, parsed_args->output,
+                parsed_args->colsB, 0, A->rows);
+#else
+  spmm_rows_scalar(A, parsed_args->input_b, parsed_args->output,
+                   parsed_args->colsB, 0, A->rows);
+#endif
+
+  return NULL;
+}
+
+static void spmm_range(void* ctx, size_t first, size_t last)
+{
+  args_t* parsed_args = (args_t*)ctx;
+
+  const csr_t* A = (const csr_t*)parsed_args->state;
+#if defined(__amd64__) || defined(__x86_64__)
+  spmm_rows_vec(A, parsed_args->input_b, parsed_args->output,
+                parsed_args->colsB, first, last);
+#else
+  spmm_rows_scalar(A, parsed_args->input_b, parsed_args->output,
+                   parsed_args->colsB, first, last);
+#endif
+}
+
+/* Parallel Implementation */
+void* impl_spmm_para(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  const csr_t* A        = (const csr_t*)parsed_args->state;
+  int          nthreads = parsed_args->nthreads < 1 ? 1 : parsed_args->nthreads;
+  if ((size_t)nthreads > A->rows) nthreads = A->rows;
+
+  /* Equal shares of nonzeros (plus one per row for the row overhead) */
+  size_t bounds[nthreads + 1];
+  size_t total = A->nnz + A->rows;
+  size_t i     = 0;
+
+  bounds[0] = 0;
+  for (int t = 1; t < nthreads; t++) {
+    size_t target = total * t / nthreads;
+    while (i < A->rows && A->rowptr[i] + i < target) i++;
+    bounds[t] = i;
+  }
+  bounds[nthreads] = A->rows;
+
+  mmult_parallel_ranges(bounds, nthreads, parsed_args->cpu, spmm_range, parsed_args);
+
+  return NULL;
+}
+
+/* Best-of-nruns runtime of impl(args) in ns */
+static uint64_t best_runtime(void* (*impl)(void*), args_t* args, int nruns)
+{
+  struct timespec ts;
+  struct timespec te;
+  uint64_t        best = UINT64_MAX;
+
+  for (int r = 0; r < nruns; r++) {
+    __SET_START_TIME();
+    (*impl)(args);
+    __SET_END_TIME();
+
+    uint64_t t = __CALC_RUNTIME();
+    if (t < best) best = t;
+  }
+
+  return best;
+}
+
+void spmm_crossover(size_t m, size_t k, size_t n,
+                    spmm_structure_t structure,
+                    int nthreads, int cpu, int nruns)
+{
+  static const double densities[] = {
+    0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.3, 0.5, 0.7, 1.0
+  };
+  const int ndensities = sizeof(densities) / sizeof(densities[0]);
+
+  float* A     = __ALLOC_DATA(float, m * k);
+  float* B     = __ALLOC_INIT_DATA(float, k * n);
+  float* C     = __ALLOC_DATA(float, m * n);
+
+  args_t args;
+  memset(&args, 0, sizeof(args));
+  args.input_a  = A;
+  args.input_b  = B;
+  args.output   = C;
+  args.rowsA    = m;
+  args.colsA    = k;
+  args.colsB    = n;
+  args.alpha    = 1.0f;
+  args.cpu      = cpu;
+  args.nthreads = nthreads;
+  epilogue_t none = { NULL, ACT_NONE, 1.0f, CVT_NONE, NULL };
+  args.epilogue = none;
+
+  printf("Sparse vs. dense crossover (%zu x %zu x %zu, %d thread(s), best of %d):\n",
+         m, k, n, nthreads, nruns);
+  printf("  %10s %12s %14s %14s %9s\n",
+         "density", "nnz", "sparse (ns)", "dense (ns)", "speedup");
+
+  double crossover = -1.0;
+  for (int d = 0; d < ndensities; d++) {
+    for (size_t e = 0; e < m * k; e++) {
+      A[e] = (float)(rand() % 1024 + 1);
+    }
+    spmm_sparsify(A, m, k, densities[d], structure);
+
+    csr_t* csr = csr_from_dense(A, m, k);
+    args.state = csr;
+    uint64_t ts_ns = best_runtime(impl_spmm_para, &args, nruns);
+    size_t   nnz   = csr->nnz;
+    csr_free(csr);
+    args.state = NULL;
+
+    uint64_t td_ns = best_runtime(impl_parallel, &args, nruns);
+
+    printf("  %10.3f %12zu %14lu %14lu %8.2fx\n", densities[d], nnz,
+           (unsigned long)ts_ns, (unsigned long)td_ns, (double)td_ns / ts_ns);
+
+    if (crossover < 0.0 && td_ns < ts_ns) {
+      crossover = densities[d];
+    }
+  }
+
+  if (crossover < 0.0) {
+    printf("  * Sparse was faster at every density\n");
+  } else {
+    printf("  * Dense blocked kernel wins from density %.3f up\n", crossover);
+  }
+  printf("\n");
+
+  free(A);
+  free(B);
+  free(C);
+}
@@ -0,0 +1,55 @@
+/* spmm.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the sparse (CSR) A times dense B implementations.
+ */
+
+#ifndef __IMPL_SPMM_H_
+#define __IMPL_SPMM_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdint.h>
+
+/* Density used when a sparse implementation is chosen without one */
+#define SPMM_DEFAULT_DENSITY 0.05
+
+/* Where the nonzeros of A go */
+typedef enum {
+  SPMM_UNIFORM,   // every element independently
+  SPMM_BANDED,    // a diagonal band of the matching width
+  SPMM_POWERLAW   // row lengths follow a Zipf law (a few very long rows)
+} spmm_structure_t;
+
+/* Compressed sparse rows */
+typedef struct {
+  size_t    rows;
+  size_t    cols;
+  size_t    nnz;
+  size_t*   rowptr;  // rows + 1 entries
+  uint32_t* colidx;  // nnz entries
+  float*    vals;    // nnz entries
+} csr_t;
+
+/* Function declaration */
+void* impl_spmm_naive(void* args);
+void* impl_spmm_vec(void* args);
+void* impl_spmm_para(void* args);
+
+/* Untimed setup and teardown (builds the CSR form of A) */
+void* impl_spmm_prep(void* args);
+void* impl_spmm_fini(void* args);
+
+/* Zero all but ~density of the dense rows x cols matrix A */
+void  spmm_sparsify(float* A, size_t rows, size_t cols,
+                    double density, spmm_structure_t structure);
+
+/* Time sparse against dense over a range of densities and report   *
+ * the density from which the dense blocked kernel is faster         */
+void  spmm_crossover(size_t m, size_t k, size_t n,
+                     spmm_structure_t structure,
+                     int nthreads, int cpu, int nruns);
+
+#endif //__IMPL_SPMM_H_
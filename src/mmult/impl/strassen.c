@@ -0,0 +1,368 @@
+/* strassen.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of Strassen-Winograd mmult
+ *
+ *  Each recursion level splits A, B, and C into 2x2 quadrants and forms
+ *  C from 7 half-size products and 15 additions (Winograd's variant).
+ *  The products are scheduled as in Douglas et al. (GEMMW), so a level
+ *  only needs two temporaries, X and Y, and reuses the quadrants of C
+ *  for the rest. Temporaries of all levels come from a single arena.
+ *
+ *  The number of levels is fixed up front: the recursion continues while
+ *  all halves stay at or above args->cutoff. Dimensions are then padded
+ *  to a multiple of 2^levels (zero rows/columns do not change C), and the
+ *  leaves run the SIMD kernel of vec, blocked the same way; the only
+ *  memory a product allocates is the padded copies and the arena.
+ *
+ *  strassen_crossover times one level of recursion against the leaf
+ *  kernel alone over a sweep of square sizes, and reports the size
+ *  from which the recursion pays off (and so the cutoff to use).
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "../include/types.h"
+#include "vec.h"
+#include "strassen.h"
+
+/* Bump allocator for the temporaries */
+typedef struct {
+  float* base;
+  size_t size;
+  size_t top;
+} arena_t;
+
+static float* arena_alloc(arena_t* arena, size_t nelems)
+{
+  /* Keep every temporary 64-byte aligned */
+  nelems = (nelems + 15) & ~(size_t)15;
+
+  float* ptr = arena->base + arena->top;
+  arena->top += nelems;
+
+  return ptr;
+}
+
+/* Z = X + Y */
+static void mat_add(size_t m, size_t n,
+                    const float* X, size_t ldx,
+                    const float* Y, size_t ldy,
+                          float* Z, size_t ldz)
+{
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      Z[i * ldz + j] = X[i * ldx + j] + Y[i * ldy + j];
+    }
+  }
+}
+
+/* Z = X - Y */
+static void mat_sub(size_t m, size_t n,
+                    const float* X, size_t ldx,
+                    const float* Y, size_t ldy,
+                          float* Z, size_t ldz)
+{
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      Z[i * ldz + j] = X[i * ldx + j] - Y[i * ldy + j];
+    }
+  }
+}
+
+/* Arena elements needed by 'levels' levels of recursion on m x k x n */
+static size_t arena_need(size_t m, size_t n, size_t k, int levels)
+{
+  size_t total = 0;
+
+  for (int l = 0; l < levels; l++) {
+    m /= 2; n /= 2; k /= 2;
+    size_t x = m * (k > n ? k : n);
+    size_t y = k * n;
+    total += ((x + 15) & ~(size_t)15) + ((y + 15) & ~(size_t)15);
+  }
+
+  return total;
+}
+
+/* C[m x n] = A[m x k] * B[k x n] with the SIMD kernel, blocked as vec */
+static void leaf(size_t m, size_t n, size_t k,
+                 const float* A, size_t lda,
+                 const float* B, size_t ldb,
+                       float* C, size_t ldc)
+{
+  for (size_t i = 0; i < m; i++) {
+    memset(&C[i * ldc], 0, n * sizeof(float));
+  }
+
+  for (size_t jj = 0; jj < n; jj += VEC_NC) {
+    size_t nb = (n - jj) < VEC_NC ? (n - jj) : VEC_NC;
+    for (size_t kk = 0; kk < k; kk += VEC_KC) {
+      size_t kb = (k - kk) < VEC_KC ? (k - kk) : VEC_KC;
+      for (size_t ii = 0; ii < m; ii += VEC_MC) {
+        size_t mb = (m - ii) < VEC_MC ? (m - ii) : VEC_MC;
+        mmult_vec_kernel(mb, nb, kb,
+                         &A[ii * lda + kk], lda,
+                         &B[kk * ldb + jj], ldb,
+                         &C[ii * ldc + jj], ldc);
+      }
+    }
+  }
+}
+
+/* C[m x n] = A[m x k] * B[k x n] */
+static void strassen(size_t m, size_t n, size_t k,
+                     const float* A, size_t lda,
+                     const float* B, size_t ldb,
+                           float* C, size_t ldc,
+                     int levels, arena_t* arena)
+{
+  /* Leaf: blocked SIMD kernel */
+  if (levels == 0) {
+    leaf(m, n, k, A, lda, B, ldb, C, ldc);
+    return;
+  }
+
+  const size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+
+  /* Quadrants */
+  const float* A11 = A;
+  const float* A12 = A + k2;
+  const float* A21 = A + m2 * lda;
+  const float* A22 = A + m2 * lda + k2;
+
+  const float* B11 = B;
+  const float* B12 = B + n2;
+  const float* B21 = B + k2 * ldb;
+  const float* B22 = B + k2 * ldb + n2;
+
+  float* C11 = C;
+  float* C12 = C + n2;
+  float* C21 = C + m2 * ldc;
+  float* C22 = C + m2 * ldc + n2;
+
+  /* Temporaries */
+  size_t mark = arena->top;
+  size_t ldx  = k2 > n2 ? k2 : n2;
+  float* X    = arena_alloc(arena, m2 * ldx);
+  float* Y    = arena_alloc(arena, k2 * n2);
+
+  const int lv = levels - 1;
+
+  /* C21 = P7 = (A11 - A21) * (B22 - B12) */
+  mat_sub(m2, k2, A11, lda, A21, lda, X, ldx);
+  mat_sub(k2, n2, B22, ldb, B12, ldb, Y, n2);
+  strassen(m2, n2, k2, X, ldx, Y, n2, C21, ldc, lv, arena);
+
+  /* C22 = P5 = (A21 + A22) * (B12 - B11) */
+  mat_add(m2, k2, A21, lda, A22, lda, X, ldx);
+  mat_sub(k2, n2, B12, ldb, B11, ldb, Y, n2);
+  strassen(m2, n2, k2, X, ldx, Y, n2, C22, ldc, lv, arena);
+
+  /* C12 = P6 = (S1 - A11) * (B22 - T1) */
+  mat_sub(m2, k2, X, ldx, A11, lda, X, ldx);
+  mat_sub(k2, n2, B22, ldb, Y, n2, Y, n2);
+  strassen(m2, n2, k2, X, ldx, Y, n2, C12, ldc, lv, arena);
+
+  /* C11 = P3 = (A12 - S2) * B22 */
+  mat_sub(m2, k2, A12, lda, X, ldx, X, ldx);
+  strassen(m2, n2, k2, X, ldx, B22, ldb, C11, ldc, lv, arena);
+
+  /* X = P1 = A11 * B11 */
+  strassen(m2, n2, k2, A11, lda, B11, ldb, X, ldx, lv, arena);
+
+  /* Combine: U2 = P1 + P6, U3 = U2 + P7, U4 = U2 + P5, *
+   *          U7 = U3 + P5, U5 = U4 + P3                */
+  mat_add(m2, n2, X  , ldx, C12, ldc, C12, ldc);
+  mat_add(m2, n2, C12, ldc, C21, ldc, C21, ldc);
+  mat_add(m2, n2, C12, ldc, C22, ldc, C12, ldc);
+  mat_add(m2, n2, C21, ldc, C22, ldc, C22, ldc);
+  mat_add(m2, n2, C12, ldc, C11, ldc, C12, ldc);
+
+  /* C11 = P4 = A22 * (T2 - B21), then C21 = U6 = U3 - P4 */
+  mat_sub(k2, n2, Y, n2, B21, ldb, Y, n2);
+  strassen(m2, n2, k2, A22, lda, Y, n2, C11, ldc, lv, arena);
+  mat_sub(m2, n2, C21, ldc, C11, ldc, C21, ldc);
+
+  /* C11 = U1 = P1 + P2 */
+  strassen(m2, n2, k2, A12, lda, B21, ldb, C11, ldc, lv, arena);
+  mat_add(m2, n2, X, ldx, C11, ldc, C11, ldc);
+
+  /* Release the temporaries of this level */
+  arena->top = mark;
+}
+
+/* Copy an m x n matrix into a zero-padded mp x np one */
+static void pad_copy(size_t m, size_t n, const float* src,
+                     size_t mp, size_t np, float* dst)
+{
+  for (size_t i = 0; i < mp; i++) {
+    if (i < m) {
+      memcpy(&dst[i * np], &src[i * n], n * sizeof(float));
+      memset(&dst[i * np + n], 0, (np - n) * sizeof(float));
+    } else {
+      memset(&dst[i * np], 0, np * sizeof(float));
+    }
+  }
+}
+
+/* Strassen-Winograd Implementation */
+void* impl_mmult_strassen(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  const float* matA  = parsed_args->input_a;
+  const float* matB  = parsed_args->input_b;
+        float* dest  = parsed_args->output;
+  size_t       rowsA = parsed_args->rowsA;
+  size_t       colsA = parsed_args->colsA;
+  size_t       colsB = parsed_args->colsB;
+  size_t       cut   = parsed_args->cutoff;
+
+  if (cut == 0) cut = STRASSEN_DEFAULT_CUTOFF;
+
+  /* Number of levels: halve while every dimension stays >= cutoff */
+  int levels = 0;
+  while ((rowsA >> (levels + 1)) >= cut &&
+         (colsA >> (levels + 1)) >= cut &&
+         (colsB >> (levels + 1)) >= cut) {
+    levels++;
+  }
+
+  /* Pad every dimension to a multiple of 2^levels */
+  size_t mult = (size_t)1 << levels;
+  size_t mp   = ((rowsA + mult - 1) / mult) * mult;
+  size_t kp   = ((colsA + mult - 1) / mult) * mult;
+  size_t np   = ((colsB + mult - 1) / mult) * mult;
+  bool   pad  = (mp != rowsA) || (kp != colsA) || (np != colsB);
+
+  const float* A = matA;
+  const float* B = matB;
+        float* C = dest;
+  float* Ap = NULL;
+  float* Bp = NULL;
+  float* Cp = NULL;
+
+  if (pad) {
+    Ap = __ALLOC_DATA(float, mp * kp);
+    Bp = __ALLOC_DATA(float, kp * np);
+    Cp = __ALLOC_DATA(float, mp * np);
+    pad_copy(rowsA, colsA, matA, mp, kp, Ap);
+    pad_copy(colsA, colsB, matB, kp, np, Bp);
+    A = Ap; B = Bp; C = Cp;
+  }
+
+  /* Arena for all temporaries */
+  arena_t arena;
+  arena.size = arena_need(mp, np, kp, levels);
+  arena.top  = 0;
+  arena.base = arena.size ? __ALLOC_DATA(float, arena.size) : NULL;
+
+  strassen(mp, np, kp, A, kp, B, np, C, np, levels, &arena);
+
+  /* Peel the padding off */
+  if (pad) {
+    for (size_t i = 0; i < rowsA; i++) {
+      memcpy(&dest[i * colsB], &Cp[i * np], colsB * sizeof(float));
+    }
+    free(Ap);
+    free(Bp);
+    free(Cp);
+  }
+
+  free(arena.base);
+
+  return NULL;
+}
+
+/* Best-of-nruns runtime of impl(args) in ns */
+static uint64_t best_runtime(void* (*impl)(void*), args_t* args, int nruns)
+{
+  struct timespec ts;
+  struct timespec te;
+  uint64_t        best = UINT64_MAX;
+
+  for (int r = 0; r < nruns; r++) {
+    __SET_START_TIME();
+    (*impl)(args);
+    __SET_END_TIME();
+
+    uint64_t t = __CALC_RUNTIME();
+    if (t < best) best = t;
+  }
+
+  return best;
+}
+
+void strassen_crossover(size_t max_dim, int nruns)
+{
+  static const size_t sizes[] = {
+    128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096
+  };
+  const int nsizes = sizeof(sizes) / sizeof(sizes[0]);
+
+  size_t top = sizes[0];
+  for (int s = 0; s < nsizes && sizes[s] <= max_dim; s++) top = sizes[s];
+
+  float* A = __ALLOC_INIT_DATA(float, top * top);
+  float* B = __ALLOC_INIT_DATA(float, top * top);
+  float* C = __ALLOC_DATA(float, top * top);
+
+  args_t args;
+  memset(&args, 0, sizeof(args));
+  args.input_a = A;
+  args.input_b = B;
+  args.output  = C;
+
+  printf("Strassen vs. blocked kernel crossover (one level, best of %d):\n", nruns);
+  printf("  %8s %14s %14s %9s\n", "n", "strassen (ns)", "vec (ns)", "speedup");
+
+  /* The crossover is the smallest size from which Strassen keeps winning */
+  size_t crossover = 0;
+  for (int s = 0; s < nsizes && sizes[s] <= top; s++) {
+    size_t n = sizes[s];
+    args.rowsA  = n;
+    args.colsA  = n;
+    args.colsB  = n;
+    args.cutoff = n / 2;
+
+    uint64_t ts_ns = best_runtime(impl_mmult_strassen, &args, nruns);
+    uint64_t tv_ns = best_runtime(impl_vector        , &args, nruns);
+
+    printf("  %8zu %14lu %14lu %8.2fx\n", n,
+           (unsigned long)ts_ns, (unsigned long)tv_ns, (double)tv_ns / ts_ns);
+
+    if (ts_ns >= tv_ns) {
+      crossover = 0;
+    } else if (crossover == 0) {
+      crossover = n;
+    }
+  }
+
+  if (crossover == 0) {
+    printf("  * The blocked kernel was faster up to n = %zu\n", top);
+  } else {
+    printf("  * Strassen wins from n = %zu up: recurse down to --cutoff %zu\n",
+           crossover, crossover / 2);
+  }
+  printf("\n");
+
+  free(A);
+  free(B);
+  free(C);
+}
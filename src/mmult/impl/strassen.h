@@ -0,0 +1,25 @@
+/* strassen.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the Strassen-Winograd mmult function.
+ */
+
+#ifndef __IMPL_STRASSEN_H_
+#define __IMPL_STRASSEN_H_
+
+/* Default recursion cutoff; below it the blocked kernel takes over */
+#define STRASSEN_DEFAULT_CUTOFF 256
+
+/* Standard C includes */
+#include <stddef.h>
+
+/* Function declaration */
+void* impl_mmult_strassen(void* args);
+
+/* Time one level of Strassen against the blocked SIMD kernel on       *
+ * square sizes up to max_dim and report the size from which it wins   */
+void  strassen_crossover(size_t max_dim, int nruns);
+
+#endif //__IMPL_STRASSEN_H_
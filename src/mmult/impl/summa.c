@@ -0,0 +1,478 @@
+/* summa.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Implementation of distributed mmult with SUMMA, one process per "node"
+ *
+ *  The P = nthreads worker processes form a pr x pc grid (pr the largest
+ *  divisor of P not above its square root). Process (r, c) owns block
+ *  (r, c) of A, B and C; the blocks live in a POSIX shared-memory segment,
+ *  but a process only ever reads its own blocks and the message slots.
+ *
+ *  SUMMA walks k in panels no wider than SUMMA_KB that never straddle an
+ *  owner. For every panel, the process column that owns those columns of
+ *  A sends them along its process row, and the process row that owns
+ *  those rows of B sends them down its process column; everybody then
+ *  adds the product of the two received panels to its C block, with
+ *  the SIMD kernel of vec (as para, ooc, and blas3 do). Sending is a
+ *  copy into a per-row (per-column) slot, and every slot is double
+ *  buffered: the next panel is posted before the current one is
+ *  multiplied, so senders run ahead of the step barrier, and the only
+ *  wait is for the slowest process of the step.
+ *
+ *  The parent scatters A and B once (untimed, but reported), starts every
+ *  run through a barrier, and gathers the C blocks into the output. The
+ *  workers are forked once and pinned to CPUs (cpu + rank); the teardown
+ *  reports the communication volume and how the wall time split between
+ *  computing, sending, and waiting.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "vec.h"
+#include "summa.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/* Per-process counters, accumulated over the runs */
+typedef struct {
+  uint64_t compute_ns;
+  uint64_t send_ns;
+  uint64_t wait_ns;
+  uint64_t bytes_sent;
+} summa_stats_t;
+
+/* Head of the shared segment */
+typedef struct {
+  pthread_barrier_t run;   // workers and parent: start and end of a run
+  pthread_barrier_t step;  // workers: end of a SUMMA step
+  volatile int      quit;
+} summa_ctrl_t;
+
+/* Grid, partitions, and the offsets of everything in the segment;    *
+ * built by the parent before forking, so every worker has a copy     */
+typedef struct {
+  int           P, pr, pc;
+  size_t        m, k, n;
+  size_t*       row_lo;    // pr + 1: rows of A and C per process row
+  size_t*       col_lo;    // pc + 1: columns of B and C per process column
+  size_t*       ka_lo;     // pc + 1: columns of A per process column
+  size_t*       kb_lo;     // pr + 1: rows of B per process row
+
+  char*         base;
+  size_t        bytes;
+  summa_ctrl_t* ctrl;
+  summa_stats_t* stats;    // P
+  float**       a_blk;     // P: m_r x ka_c
+  float**       b_blk;     // P: kb_r x n_c
+  float**       c_blk;     // P: m_r x n_c
+  float**       a_slot;    // 2 pr: m_r x SUMMA_KB
+  float**       b_slot;    // 2 pc: SUMMA_KB x n_c
+
+  pid_t*        pids;
+  int           cpu;
+  uint64_t      runs;
+  uint64_t      wall_ns;
+  uint64_t      gather_ns;
+} summa_t;
+
+static inline uint64_t now_ns(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000llu + t.tv_nsec;
+}
+
+/* Even split of len into parts */
+static size_t* split(size_t len, int parts)
+{
+  size_t* lo = (size_t*)malloc((parts + 1) * sizeof(size_t));
+  for (int p = 0; p <= parts; p++) {
+    lo[p] = len * p / parts;
+  }
+  return lo;
+}
+
+/* Owner of index x in a split */
+static int owner(const size_t* lo, int parts, size_t x)
+{
+  int p = 0;
+  while (p + 1 < parts && lo[p + 1] <= x) p++;
+  return p;
+}
+
+/* End of the panel starting at k0: at most SUMMA_KB wide, and within *
+ * one owner of A's columns and one owner of B's rows                  */
+static size_t panel_end(const summa_t* s, size_t k0)
+{
+  size_t k1 = MIN(k0 + SUMMA_KB, s->k);
+  k1 = MIN(k1, s->ka_lo[owner(s->ka_lo, s->pc, k0) + 1]);
+  k1 = MIN(k1, s->kb_lo[owner(s->kb_lo, s->pr, k0) + 1]);
+  return k1;
+}
+
+/* Send panel [k0, k1) into slot 'slot' if this process owns part of it */
+static void post_panel(summa_t* s, int rank, size_t k0, size_t k1, int slot)
+{
+  int    r  = rank / s->pc;
+  int    c  = rank % s->pc;
+  size_t w  = k1 - k0;
+  size_t mr = s->row_lo[r + 1] - s->row_lo[r];
+  size_t nc = s->col_lo[c + 1] - s->col_lo[c];
+
+  uint64_t t0 = now_ns();
+
+  if (owner(s->ka_lo, s->pc, k0) == c) {
+    size_t       ka  = s->ka_lo[c + 1] - s->ka_lo[c];
+    const float* src = s->a_blk[rank] + (k0 - s->ka_lo[c]);
+    float*       dst = s->a_slot[2 * r + slot];
+    for (size_t i = 0; i < mr; i++) {
+      memcpy(&dst[i * w], &src[i * ka], w * sizeof(float));
+    }
+    s->stats[rank].bytes_sent += (uint64_t)mr * w * sizeof(float) * (s->pc - 1);
+  }
+
+  if (owner(s->kb_lo, s->pr, k0) == r) {
+    const float* src = s->b_blk[rank] + (k0 - s->kb_lo[r]) * nc;
+    float*       dst = s->b_slot[2 * c + slot];
+    memcpy(dst, src, w * nc * sizeof(float));
+    s->stats[rank].bytes_sent += (uint64_t)w * nc * sizeof(float) * (s->pr - 1);
+  }
+
+  s->stats[rank].send_ns += now_ns() - t0;
+}
+
+/* C[m x n] += A[m x k] * B[k x n], the local product of one step, *
+ * with the SIMD kernel blocked as in vec                            */
+static void local_product(size_t m, size_t n, size_t k,
+                          const float* A, const float* B, float* C)
+{
+  for (size_t jj = 0; jj < n; jj += VEC_NC) {
+    size_t nb = MIN(VEC_NC, n - jj);
+    for (size_t kk = 0; kk < k; kk += VEC_KC) {
+      size_t kb = MIN(VEC_KC, k - kk);
+      for (size_t ii = 0; ii < m; ii += VEC_MC) {
+        size_t mb = MIN(VEC_MC, m - ii);
+        mmult_vec_kernel(mb, nb, kb,
+                         &A[ii * k + kk], k,
+                         &B[kk * n + jj], n,
+                         &C[ii * n + jj], n);
+      }
+    }
+  }
+}
+
+/* One SUMMA product on process 'rank' */
+static void summa_run(summa_t* s, int rank)
+{
+  int    r  = rank / s->pc;
+  int    c  = rank % s->pc;
+  size_t mr = s->row_lo[r + 1] - s->row_lo[r];
+  size_t nc = s->col_lo[c + 1] - s->col_lo[c];
+  float* C  = s->c_blk[rank];
+
+  memset(C, 0, mr * nc * sizeof(float));
+
+  size_t k0   = 0;
+  size_t k1   = panel_end(s, k0);
+  int    slot = 0;
+
+  post_panel(s, rank, k0, k1, slot);
+  pthread_barrier_wait(&s->ctrl->step);
+
+  while (k0 < s->k) {
+    /* Run ahead: post the next panel into the other slot */
+    size_t k2 = (k1 < s->k) ? panel_end(s, k1) : k1;
+    if (k1 < s->k) {
+      post_panel(s, rank, k1, k2, slot ^ 1);
+    }
+
+    uint64_t t0 = now_ns();
+    if (mr > 0 && nc > 0) {
+      local_product(mr, nc, k1 - k0,
+                    s->a_slot[2 * r + slot], s->b_slot[2 * c + slot], C);
+    }
+    uint64_t t1 = now_ns();
+    pthread_barrier_wait(&s->ctrl->step);
+    uint64_t t2 = now_ns();
+
+    s->stats[rank].compute_ns += t1 - t0;
+    s->stats[rank].wait_ns    += t2 - t1;
+
+    k0 = k1; k1 = k2; slot ^= 1;
+  }
+}
+
+static void summa_worker(summa_t* s, int rank)
+{
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(s->cpu + rank, &cpuset);
+  int __attribute__((unused)) res = sched_setaffinity(0, sizeof(cpuset), &cpuset);
+
+  for (;;) {
+    pthread_barrier_wait(&s->ctrl->run);
+    if (s->ctrl->quit) {
+      _exit(0);
+    }
+    summa_run(s, rank);
+    pthread_barrier_wait(&s->ctrl->run);
+  }
+}
+
+/* Carve 'bytes' out of the segment, cache-line aligned */
+static void* carve(summa_t* s, size_t* off, size_t bytes)
+{
+  void* p = (s->base != NULL) ? s->base + *off : NULL;
+  *off += (bytes + 63) & ~(size_t)63;
+  return p;
+}
+
+/* Lay out the segment; with base == NULL only its size is computed */
+static size_t summa_layout(summa_t* s)
+{
+  size_t off = 0;
+
+  s->ctrl  = (summa_ctrl_t* )carve(s, &off, sizeof(summa_ctrl_t));
+  s->stats = (summa_stats_t*)carve(s, &off, s->P * sizeof(summa_stats_t));
+
+  for (int rank = 0; rank < s->P; rank++) {
+    int    r  = rank / s->pc;
+    int    c  = rank % s->pc;
+    size_t mr = s->row_lo[r + 1] - s->row_lo[r];
+    size_t nc = s->col_lo[c + 1] - s->col_lo[c];
+    size_t ka = s->ka_lo[c + 1] - s->ka_lo[c];
+    size_t kb = s->kb_lo[r + 1] - s->kb_lo[r];
+
+    s->a_blk[rank] = (float*)carve(s, &off, mr * ka * sizeof(float));
+    s->b_blk[rank] = (float*)carve(s, &off, kb * nc * sizeof(float));
+    s->c_blk[rank] = (float*)carve(s, &off, mr * nc * sizeof(float));
+  }
+
+  for (int r = 0; r < s->pr; r++) {
+    size_t mr = s->row_lo[r + 1] - s->row_lo[r];
+    s->a_slot[2 * r + 0] = (float*)carve(s, &off, mr * SUMMA_KB * sizeof(float));
+    s->a_slot[2 * r + 1] = (float*)carve(s, &off, mr * SUMMA_KB * sizeof(float));
+  }
+  for (int c = 0; c < s->pc; c++) {
+    size_t nc = s->col_lo[c + 1] - s->col_lo[c];
+    s->b_slot[2 * c + 0] = (float*)carve(s, &off, SUMMA_KB * nc * sizeof(float));
+    s->b_slot[2 * c + 1] = (float*)carve(s, &off, SUMMA_KB * nc * sizeof(float));
+  }
+
+  return off;
+}
+
+void* impl_mmult_summa_prep(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  summa_t* s = (summa_t*)calloc(1, sizeof(summa_t));
+  s->P        = parsed_args->nthreads < 1 ? 1 : parsed_args->nthreads;
+  s->m        = parsed_args->rowsA;
+  s->k        = parsed_args->colsA;
+  s->n        = parsed_args->colsB;
+  s->cpu      = parsed_args->cpu;
+
+  /* The most square grid */
+  s->pr = 1;
+  for (int d = 1; d * d <= s->P; d++) {
+    if (s->P % d == 0) s->pr = d;
+  }
+  s->pc = s->P / s->pr;
+
+  s->row_lo = split(s->m, s->pr);
+  s->col_lo = split(s->n, s->pc);
+  s->ka_lo  = split(s->k, s->pc);
+  s->kb_lo  = split(s->k, s->pr);
+
+  s->a_blk  = (float**)malloc(s->P * sizeof(float*));
+  s->b_blk  = (float**)malloc(s->P * sizeof(float*));
+  s->c_blk  = (float**)malloc(s->P * sizeof(float*));
+  s->a_slot = (float**)malloc(2 * s->pr * sizeof(float*));
+  s->b_slot = (float**)malloc(2 * s->pc * sizeof(float*));
+  s->pids   = (pid_t* )malloc(s->P * sizeof(pid_t));
+
+  /* Shared segment, unlinked at once: the mapping survives fork() */
+  char name[64];
+  snprintf(name, sizeof(name), "/mmult_summa_%d", (int)getpid());
+  s->bytes = summa_layout(s);
+
+  int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0 || ftruncate(fd, s->bytes) != 0) {
+    printf("\n  ERROR: Cannot create the shared-memory segment!\n\n");
+    exit(-2);
+  }
+  s->base = (char*)mmap(NULL, s->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  shm_unlink(name);
+  if (s->base == MAP_FAILED) {
+    printf("\n  ERROR: Cannot map the shared-memory segment!\n\n");
+    exit(-2);
+  }
+  summa_layout(s);
+
+  pthread_barrierattr_t attr;
+  pthread_barrierattr_init(&attr);
+  pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+  pthread_barrier_init(&s->ctrl->run , &attr, s->P + 1);
+  pthread_barrier_init(&s->ctrl->step, &attr, s->P);
+  pthread_barrierattr_destroy(&attr);
+  s->ctrl->quit = 0;
+
+  /* Scatter A and B */
+  uint64_t t0 = now_ns();
+  const float* A = parsed_args->input_a;
+  const float* B = parsed_args->input_b;
+  for (int rank = 0; rank < s->P; rank++) {
+    int    r  = rank / s->pc;
+    int    c  = rank % s->pc;
+    size_t ka = s->ka_lo[c + 1] - s->ka_lo[c];
+    size_t nc = s->col_lo[c + 1] - s->col_lo[c];
+
+    for (size_t i = s->row_lo[r]; i < s->row_lo[r + 1]; i++) {
+      memcpy(&s->a_blk[rank][(i - s->row_lo[r]) * ka],
+             &A[i * s->k + s->ka_lo[c]], ka * sizeof(float));
+    }
+    for (size_t p = s->kb_lo[r]; p < s->kb_lo[r + 1]; p++) {
+      memcpy(&s->b_blk[rank][(p - s->kb_lo[r]) * nc],
+             &B[p * s->n + s->col_lo[c]], nc * sizeof(float));
+    }
+  }
+  uint64_t t1 = now_ns();
+
+  printf("  * SUMMA: %d processes on a %d x %d grid, %.1f MB shared\n",
+         s->P, s->pr, s->pc, s->bytes / 1e6);
+  printf("  * Scattering A and B (%.1f MB) took %" PRIu64 " ns\n",
+         (s->m * s->k + s->k * s->n) * sizeof(float) / 1e6, t1 - t0);
+
+  /* Workers never return */
+  for (int rank = 0; rank < s->P; rank++) {
+    s->pids[rank] = fork();
+    if (s->pids[rank] == 0) {
+      summa_worker(s, rank);
+    } else if (s->pids[rank] < 0) {
+      printf("\n  ERROR: Cannot fork a SUMMA worker!\n\n");
+      exit(-2);
+    }
+  }
+
+  parsed_args->state = s;
+
+  return NULL;
+}
+
+void* impl_mmult_summa_fini(void* args)
+{
+  args_t*  parsed_args = (args_t*)args;
+  summa_t* s           = (summa_t*)parsed_args->state;
+
+  if (s == NULL) return NULL;
+
+  s->ctrl->quit = 1;
+  pthread_barrier_wait(&s->ctrl->run);
+  for (int rank = 0; rank < s->P; rank++) {
+    waitpid(s->pids[rank], NULL, 0);
+  }
+
+  if (s->runs > 0) {
+    /* Each A element goes to pc - 1 other processes, each B element *
+     * to pr - 1, and each C element once to the parent               */
+    uint64_t bcast  = 0;
+    uint64_t busy   = 0;
+    for (int rank = 0; rank < s->P; rank++) {
+      bcast += s->stats[rank].bytes_sent;
+      busy  += s->stats[rank].compute_ns;
+    }
+    bcast /= s->runs;
+    uint64_t gather = s->m * s->n * sizeof(float);
+
+    printf("  * SUMMA communication per run: %.2f MB broadcast + %.2f MB gathered\n",
+           bcast / 1e6, gather / 1e6);
+    printf("  * SUMMA time per run (avg. of %" PRIu64 "): %" PRIu64 " ns wall, %" PRIu64 " ns gather\n",
+           s->runs, s->wall_ns / s->runs, s->gather_ns / s->runs);
+    for (int rank = 0; rank < s->P; rank++) {
+      printf("    + Process (%d, %d): compute %" PRIu64 ", send %" PRIu64 ", wait %" PRIu64 " ns\n",
+             rank / s->pc, rank % s->pc,
+             s->stats[rank].compute_ns / s->runs,
+             s->stats[rank].send_ns    / s->runs,
+             s->stats[rank].wait_ns    / s->runs);
+    }
+    printf("  * SUMMA efficiency (compute / (P x wall)): %.1f%%\n",
+           100.0 * busy / ((double)s->P * s->wall_ns));
+  }
+
+  pthread_barrier_destroy(&s->ctrl->run);
+  pthread_barrier_destroy(&s->ctrl->step);
+  munmap(s->base, s->bytes);
+
+  free(s->row_lo);
+  free(s->col_lo);
+  free(s->ka_lo);
+  free(s->kb_lo);
+  free(s->a_blk);
+  free(s->b_blk);
+  free(s->c_blk);
+  free(s->a_slot);
+  free(s->b_slot);
+  free(s->pids);
+  free(s);
+  parsed_args->state = NULL;
+
+  return NULL;
+}
+
+/* Distributed Implementation */
+void* impl_mmult_summa(void* args)
+{
+  /* Get the argument struct */
+  args_t*  parsed_args = (args_t*)args;
+  summa_t* s           = (summa_t*)parsed_args->state;
+  float*   dest        = parsed_args->output;
+
+  uint64_t t0 = now_ns();
+
+  /* Start the workers and wait for them to finish */
+  pthread_barrier_wait(&s->ctrl->run);
+  pthread_barrier_wait(&s->ctrl->run);
+
+  /* Gather C */
+  uint64_t t1 = now_ns();
+  for (int rank = 0; rank < s->P; rank++) {
+    int    r  = rank / s->pc;
+    int    c  = rank % s->pc;
+    size_t nc = s->col_lo[c + 1] - s->col_lo[c];
+
+    for (size_t i = s->row_lo[r]; i < s->row_lo[r + 1]; i++) {
+      memcpy(&dest[i * s->n + s->col_lo[c]],
+             &s->c_blk[rank][(i - s->row_lo[r]) * nc], nc * sizeof(float));
+    }
+  }
+  uint64_t t2 = now_ns();
+
+  s->runs      += 1;
+  s->wall_ns   += t2 - t0;
+  s->gather_ns += t2 - t1;
+
+  return NULL;
+}
@@ -0,0 +1,23 @@
+/* summa.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the multi-process (SUMMA over shared memory) mmult.
+ */
+
+#ifndef __IMPL_SUMMA_H_
+#define __IMPL_SUMMA_H_
+
+/* Width of the k-panels broadcast at every SUMMA step */
+#define SUMMA_KB 256
+
+/* Function declaration */
+void* impl_mmult_summa(void* args);
+
+/* Untimed setup (scatter A and B, fork the workers) and teardown     *
+ * (stop the workers, report communication volume and efficiency)    */
+void* impl_mmult_summa_prep(void* args);
+void* impl_mmult_summa_fini(void* args);
+
+#endif //__IMPL_SUMMA_H_
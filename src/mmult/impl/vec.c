@@ -1,13 +1,26 @@
 /* vec.c
  *
- * Author:
- * Date  :
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
  *
- *  Description
+ *  Implementation of vectorized mmult
+ *
+ *  The base case is a fixed 6x16 register tile: 12 AVX accumulators
+ *  hold a 6-row by 16-column block of C while the k loop broadcasts
+ *  one element of A per row and streams two vectors of B. Tiles that
+ *  do not fill 6x16 fall back to a masked single-row kernel. The full
+ *  implementation simply blocks the three loops around that base case.
  */
 
-/* Standard C includes */
+/* Standard C includes  */
 #include <stdlib.h>
+#include <string.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+#include <arm_neon.h>
+#endif
 
 /* Include common headers */
 #include "common/macros.h"
@@ -15,12 +28,147 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "vec.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Lane mask with the first 'cols' lanes (0..8) active */
+static inline __m256i tail_mask(size_t cols)
+{
+  const __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)cols), idx);
+}
+
+/* C[6 x 16] += A[6 x k] * B[k x 16] */
+__attribute__((target("avx2,fma")))
+static void kernel_6x16(size_t k,
+                        const float* A, size_t lda,
+                        const float* B, size_t ldb,
+                              float* C, size_t ldc)
+{
+  __m256 c00 = _mm256_loadu_ps(&C[0 * ldc]), c01 = _mm256_loadu_ps(&C[0 * ldc + 8]);
+  __m256 c10 = _mm256_loadu_ps(&C[1 * ldc]), c11 = _mm256_loadu_ps(&C[1 * ldc + 8]);
+  __m256 c20 = _mm256_loadu_ps(&C[2 * ldc]), c21 = _mm256_loadu_ps(&C[2 * ldc + 8]);
+  __m256 c30 = _mm256_loadu_ps(&C[3 * ldc]), c31 = _mm256_loadu_ps(&C[3 * ldc + 8]);
+  __m256 c40 = _mm256_loadu_ps(&C[4 * ldc]), c41 = _mm256_loadu_ps(&C[4 * ldc + 8]);
+  __m256 c50 = _mm256_loadu_ps(&C[5 * ldc]), c51 = _mm256_loadu_ps(&C[5 * ldc + 8]);
+
+  for (size_t p = 0; p < k; p++) {
+    __m256 b0 = _mm256_loadu_ps(&B[p * ldb    ]);
+    __m256 b1 = _mm256_loadu_ps(&B[p * ldb + 8]);
+    __m256 a;
+
+    a = _mm256_broadcast_ss(&A[0 * lda + p]);
+    c00 = _mm256_fmadd_ps(a, b0, c00); c01 = _mm256_fmadd_ps(a, b1, c01);
+    a = _mm256_broadcast_ss(&A[1 * lda + p]);
+    c10 = _mm256_fmadd_ps(a, b0, c10); c11 = _mm256_fmadd_ps(a, b1, c11);
+    a = _mm256_broadcast_ss(&A[2 * lda + p]);
+    c20 = _mm256_fmadd_ps(a, b0, c20); c21 = _mm256_fmadd_ps(a, b1, c21);
+    a = _mm256_broadcast_ss(&A[3 * lda + p]);
+    c30 = _mm256_fmadd_ps(a, b0, c30); c31 = _mm256_fmadd_ps(a, b1, c31);
+    a = _mm256_broadcast_ss(&A[4 * lda + p]);
+    c40 = _mm256_fmadd_ps(a, b0, c40); c41 = _mm256_fmadd_ps(a, b1, c41);
+    a = _mm256_broadcast_ss(&A[5 * lda + p]);
+    c50 = _mm256_fmadd_ps(a, b0, c50); c51 = _mm256_fmadd_ps(a, b1, c51);
+  }
+
+  _mm256_storeu_ps(&C[0 * ldc], c00); _mm256_storeu_ps(&C[0 * ldc + 8], c01);
+  _mm256_storeu_ps(&C[1 * ldc], c10); _mm256_storeu_ps(&C[1 * ldc + 8], c11);
+  _mm256_storeu_ps(&C[2 * ldc], c20); _mm256_storeu_ps(&C[2 * ldc + 8], c21);
+  _mm256_storeu_ps(&C[3 * ldc], c30); _mm256_storeu_ps(&C[3 * ldc + 8], c31);
+  _mm256_storeu_ps(&C[4 * ldc], c40); _mm256_storeu_ps(&C[4 * ldc + 8], c41);
+  _mm256_storeu_ps(&C[5 * ldc], c50); _mm256_storeu_ps(&C[5 * ldc + 8], c51);
+}
+
+/* C[1 x cols] += A[1 x k] * B[k x cols], cols <= 16 */
+__attribute__((target("avx2,fma")))
+static void kernel_1x16(size_t k, size_t cols,
+                        const float* A,
+                        const float* B, size_t ldb,
+                              float* C)
+{
+  __m256i m0 = tail_mask(cols > 8 ? 8 : cols);
+  __m256i m1 = tail_mask(cols > 8 ? cols - 8 : 0);
+
+  __m256 c0 = _mm256_maskload_ps(&C[0], m0);
+  __m256 c1 = _mm256_maskload_ps(&C[8], m1);
 
-/* Alternative Implementation */
-#pragma GCC push_options
-#pragma GCC optimize ("O1")
+  for (size_t p = 0; p < k; p++) {
+    __m256 a  = _mm256_broadcast_ss(&A[p]);
+    __m256 b0 = _mm256_maskload_ps(&B[p * ldb    ], m0);
+    __m256 b1 = _mm256_maskload_ps(&B[p * ldb + 8], m1);
+    c0 = _mm256_fmadd_ps(a, b0, c0);
+    c1 = _mm256_fmadd_ps(a, b1, c1);
+  }
+
+  _mm256_maskstore_ps(&C[0], m0, c0);
+  _mm256_maskstore_ps(&C[8], m1, c1);
+}
+#endif
+
+/* C[m x n] += A[m x k] * B[k x n] with the 6x16 base case */
+void mmult_vec_kernel(size_t m, size_t n, size_t k,
+                      const float* A, size_t lda,
+                      const float* B, size_t ldb,
+                            float* C, size_t ldc)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  for (size_t j = 0; j < n; j += VEC_NR) {
+    size_t cols = (n - j) < VEC_NR ? (n - j) : VEC_NR;
+    size_t i    = 0;
+
+    if (cols == VEC_NR) {
+      for (; i + VEC_MR <= m; i += VEC_MR) {
+        kernel_6x16(k, &A[i * lda], lda, &B[j], ldb, &C[i * ldc + j], ldc);
+      }
+    }
+
+    for (; i < m; i++) {
+      kernel_1x16(k, cols, &A[i * lda], &B[j], ldb, &C[i * ldc + j]);
+    }
+  }
+#else
+  for (size_t i = 0; i < m; i++) {
+    for (size_t p = 0; p < k; p++) {
+      float a = A[i * lda + p];
+      for (size_t j = 0; j < n; j++) {
+        C[i * ldc + j] += a * B[p * ldb + j];
+      }
+    }
+  }
+#endif
+}
+
+/* Vectorized Implementation */
 void* impl_vector(void* args)
 {
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  const float* matA  = parsed_args->input_a;
+  const float* matB  = parsed_args->input_b;
+        float* dest  = parsed_args->output;
+  size_t       rowsA = parsed_args->rowsA;
+  size_t       colsA = parsed_args->colsA;
+  size_t       colsB = parsed_args->colsB;
+
+  /* Initialize destination matrix */
+  memset(dest, 0, rowsA * colsB * sizeof(float));
+
+  /* Block the three loops around the base case */
+  for (size_t jj = 0; jj < colsB; jj += VEC_NC) {
+    size_t nb = (colsB - jj) < VEC_NC ? (colsB - jj) : VEC_NC;
+    for (size_t kk = 0; kk < colsA; kk += VEC_KC) {
+      size_t kb = (colsA - kk) < VEC_KC ? (colsA - kk) : VEC_KC;
+      for (size_t ii = 0; ii < rowsA; ii += VEC_MC) {
+        size_t mb = (rowsA - ii) < VEC_MC ? (rowsA - ii) : VEC_MC;
+        mmult_vec_kernel(mb, nb, kb,
+                         &matA[ii * colsA + kk], colsA,
+                         &matB[kk * colsB + jj], colsB,
+                         &dest[ii * colsB + jj], colsB);
+      }
+    }
+  }
+
   return NULL;
 }
-#pragma GCC pop_options
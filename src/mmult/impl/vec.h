@@ -1,15 +1,33 @@
-/* opt.h
+/* vec.h
  *
  * Author: Khalid Al-Hawaj
  * Date  : 13 Nov. 2023
  *
- * Header for scalar optimized function.
+ * Header for vectorized function.
  */
 
 #ifndef __IMPL_VEC_H_
 #define __IMPL_VEC_H_
 
+/* Standard C includes */
+#include <stddef.h>
+
+/* Register tile of the base case */
+#define VEC_MR  6
+#define VEC_NR 16
+
+/* Cache blocking around the base case */
+#define VEC_MC  96
+#define VEC_KC 256
+#define VEC_NC 512
+
 /* Function declaration */
 void* impl_vector(void* args);
 
+/* SIMD base case, shared with other implementations */
+void  mmult_vec_kernel(size_t m, size_t n, size_t k,
+                       const float* A, size_t lda,
+                       const float* B, size_t ldb,
+                             float* C, size_t ldc);
+
 #endif //__IMPL_VEC_H_
@@ -9,6 +9,74 @@
 #ifndef __INCLUDE_TYPES_H_
 #define __INCLUDE_TYPES_H_
 
+/* Standard C includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/* Blocking parameters of the blocked (opt) kernel:
+ *   mc x kc -> block of A kept in L2
+ *   kc x nc -> panel of B kept in L3
+ *   mr x nr -> register tile updated by the micro-kernel
+ * A zero field means "use the built-in default".
+ */
+typedef struct {
+  size_t mc;
+  size_t kc;
+  size_t nc;
+  size_t mr;
+  size_t nr;
+} blocking_t;
+
+/* Element type of the operands. The matrices always travel as float
+ * pointers; the double and complex implementations reinterpret them:
+ *   DTYPE_DOUBLE        -> double[rows * cols]
+ *   DTYPE_COMPLEX       -> float[rows * cols * 2], (re, im) pairs
+ *   DTYPE_COMPLEX_SPLIT -> float[rows * cols] real plane, followed by
+ *                          float[rows * cols] imaginary plane
+ */
+typedef enum {
+  DTYPE_FLOAT,
+  DTYPE_DOUBLE,
+  DTYPE_COMPLEX,
+  DTYPE_COMPLEX_SPLIT
+} dtype_t;
+
+/* Fused epilogue, applied to every element of C before it is stored:
+ *   C = scale * act(alpha * op(A) * op(B) + beta * C + bias[col])
+ * and optionally narrowed to a 16-bit type on the way out.
+ */
+typedef enum {
+  ACT_NONE,
+  ACT_RELU,
+  ACT_GELU
+} activation_t;
+
+typedef enum {
+  CVT_NONE,   // store float into output
+  CVT_BF16,   // store bfloat16 into 'converted'; output is scratch
+  CVT_FP16    // store IEEE half into 'converted'; output is scratch
+} conversion_t;
+
+typedef struct {
+  const float*  bias;       // Per-column bias (colsB entries), or NULL
+  activation_t  act;
+  float         scale;
+  conversion_t  cvt;
+  uint16_t*     converted;  // rowsA x ldc, used with CVT_BF16/CVT_FP16
+} epilogue_t;
+
+/* Storage of an operand. LAYOUT_COL composes with the transpose flag
+ * (a transposed column-major operand is read row-major). LAYOUT_TILED
+ * is the blocked format of impl/layout.h, built from op(X).
+ */
+typedef enum {
+  LAYOUT_ROW,
+  LAYOUT_COL,
+  LAYOUT_TILED
+} layout_t;
+
 typedef struct {
   float* input_a;  // Pointer to the first input matrix
   float* input_b;  // Pointer to the second input matrix
@@ -20,8 +88,68 @@ typedef struct {
 
   size_t size;
 
+  dtype_t    dtype;
+
+  /* C = alpha * op(A) * op(B) + beta * C, then the epilogue. With
+   * trans_a, A is stored colsA x rowsA (likewise B). A leading
+   * dimension of 0 means "tightly packed". Only ref and opt honour
+   * all of these (naive honours transposes, strides, and layouts);
+   * every other implementation assumes the defaults (alpha = 1,
+   * beta = 0, no transposes, tight, row-major, no epilogue).        */
+  float      alpha;
+  float      beta;
+  bool       trans_a;
+  bool       trans_b;
+  size_t     lda;
+  size_t     ldb;
+  size_t     ldc;
+  layout_t   layout_a;   // Tiled operands are opt-only
+  layout_t   layout_b;
+  epilogue_t epilogue;
+
+  blocking_t blocking;
+  size_t     cutoff;    // Strassen: smallest dimension worth recursing on
+  double     dirty_a;   // Incremental: fraction of A rows changed per run
+  double     dirty_b;   // Incremental: fraction of B columns changed per run
+  size_t     mem_limit; // Out-of-core: bytes of the operands held in memory
+
+  void*   state;        // Implementation-private data, built by its prep
+  FILE*   notes;        // Where preps print their notes (NULL = stdout)
+
   int     cpu;
   int     nthreads;
 } args_t;
 
+/* Layouts of a batch of small matrices */
+typedef enum {
+  BATCH_LAYOUT_PTR,      // array of pointers, one per matrix
+  BATCH_LAYOUT_STRIDED,  // matrix b at base + b * stride
+  BATCH_LAYOUT_COMPACT   // groups of 8 matrices interleaved element-wise
+} batch_layout_t;
+
+typedef struct {
+  batch_layout_t layout;
+
+  size_t count;          // Number of products in the batch
+  size_t m;              // Rows of every A (and C)
+  size_t k;              // Columns of every A, rows of every B
+  size_t n;              // Columns of every B (and C)
+
+  /* BATCH_LAYOUT_PTR */
+  const float** a_array;
+  const float** b_array;
+        float** c_array;
+
+  /* BATCH_LAYOUT_STRIDED and BATCH_LAYOUT_COMPACT */
+  const float* a;
+  const float* b;
+        float* c;
+  size_t stride_a;
+  size_t stride_b;
+  size_t stride_c;
+
+  int     cpu;
+  int     nthreads;
+} batch_args_t;
+
 #endif //__INCLUDE_TYPES_H_
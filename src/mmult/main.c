@@ -46,6 +46,33 @@
 #include "impl/ref.h"
 #include "impl/naive.h"
 #include "impl/opt.h"
+#include "impl/strassen.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+#include "impl/gemv.h"
+#include "impl/recursive.h"
+#include "impl/batch.h"
+#include "impl/int8.h"
+#include "impl/half.h"
+#include "impl/dgemm.h"
+#include "impl/cgemm.h"
+#include "impl/epilogue.h"
+#include "impl/layout.h"
+#include "impl/spmm.h"
+#include "impl/summa.h"
+#include "impl/incr.h"
+#include "impl/jit.h"
+#include "impl/ooc.h"
+#include "impl/blas3.h"
+
+/* Include the blocking auto-tuner */
+#include "tune/tune.h"
+
+/* Include the shape-driven kernel selection */
+#include "tune/autosel.h"
+
+/* Include the shape-suite benchmark */
+#include "suite/suite.h"
 
 /* Include common headers */
 #include "common/types.h"
@@ -74,19 +101,86 @@ int main(int argc, char** argv)
   int mA_rows = A_ROW;
   int mAB_cols_rows = A_COL_B_ROW;
   int mB_cols = B_COL;
-  int matrix_a_data_size = A_ROW * A_COL_B_ROW;
-  int matrix_b_data_size = A_COL_B_ROW * B_COL;
-  int data_size = A_ROW * B_COL;
+  bool dims_set = false;
+
+  /* Batched mode: number of products and their layout */
+  int            batch        = 0;
+  batch_layout_t batch_layout = BATCH_LAYOUT_STRIDED;
+
+  /* Element type */
+  dtype_t dtype = DTYPE_FLOAT;
+
+  /* GEMM interface: C = epilogue(alpha * op(A) * op(B) + beta * C) */
+  float        alpha   = 1.0f;
+  float        beta    = 0.0f;
+  bool         trans_a = false;
+  bool         trans_b = false;
+  int          lda     = 0;
+  int          ldb     = 0;
+  int          ldc     = 0;
+  bool         bias    = false;
+  activation_t act     = ACT_NONE;
+  float        scale   = 1.0f;
+  conversion_t cvt     = CVT_NONE;
+
+  /* Operand layouts */
+  layout_t     layout_a = LAYOUT_ROW;
+  layout_t     layout_b = LAYOUT_ROW;
+
+  /* Sparse A: fraction of nonzeros kept (< 0 = dense) and where */
+  double           density   = -1.0;
+  spmm_structure_t structure = SPMM_UNIFORM;
+  bool             crossover = false;
+
+  /* Incremental: fractions of A rows and B columns changed per run */
+  double dirty_a = -1.0;
+  double dirty_b = -1.0;
+
+  /* Out-of-core: memory budget (0 = default) and standalone files */
+  size_t      mem_limit = 0;
+  const char* ooc_files[3] = { NULL, NULL, NULL };
+
+  /* Strassen recursion cutoff, and the sweep that measures it */
+  int  cutoff          = STRASSEN_DEFAULT_CUTOFF;
+  bool strassen_sweep  = false;
+
+  /* Tuning */
+  bool        tune      = false;
+  const char* tune_file = NULL;
+
+  /* Kernel selection (-i auto) */
+  bool        auto_select = false;
+  bool        calibrate   = false;
+  const char* auto_file   = NULL;
+
+  /* Shape suite (NULL = a single shape) */
+  const char* suite     = NULL;
 
   /* Parse arguments */
   /* Function pointers */
   void* (*impl_mmult_opt_ptr  )(void* args) = impl_mmult_opt;
   void* (*impl_mmult_naive_ptr)(void* args) = impl_mmult_naive;
+  void* (*impl_mmult_strassen_ptr)(void* args) = impl_mmult_strassen;
+  void* (*impl_vector_ptr)(void* args) = impl_vector;
+  void* (*impl_parallel_ptr)(void* args) = impl_parallel;
+  void* (*impl_mmult_gemv_ptr)(void* args) = impl_mmult_gemv;
+  void* (*impl_mmult_recursive_ptr)(void* args) = impl_mmult_recursive;
+  void* (*impl_mmult_batch_ptr)(void* args) = impl_mmult_batch;
+  void* (*impl_mmult_int8_ptr)(void* args) = impl_mmult_int8;
+  void* (*impl_mmult_fp16_ptr)(void* args) = impl_mmult_fp16;
+  void* (*impl_mmult_bf16_ptr)(void* args) = impl_mmult_bf16;
 
   /* Chosen */
   void* (*impl)(void* args) = NULL;
   const char* impl_str      = NULL;
 
+  /* Optional untimed setup/teardown of the chosen implementation */
+  void* (*impl_prep)(void* args) = NULL;
+  void* (*impl_fini)(void* args) = NULL;
+
+  /* Optional untimed step before every run of it */
+  void* (*impl_step)(void* args) = NULL;
+
   bool help = false;
   for (int i = 1; i < argc; i++) {
     /* Implementations */
@@ -96,6 +190,69 @@ int main(int argc, char** argv)
         impl = impl_mmult_naive_ptr; impl_str = "mmult_naive";
       } else if (strcmp(argv[i], "opt"  ) == 0) {
         impl = impl_mmult_opt_ptr  ; impl_str = "mmult_opt"  ;
+        impl_prep = impl_mmult_opt_prep; impl_fini = impl_mmult_opt_fini;
+      } else if (strcmp(argv[i], "strassen") == 0) {
+        impl = impl_mmult_strassen_ptr; impl_str = "mmult_strassen";
+      } else if (strcmp(argv[i], "vec"  ) == 0) {
+        impl = impl_vector_ptr     ; impl_str = "mmult_vec"   ;
+      } else if (strcmp(argv[i], "para" ) == 0) {
+        impl = impl_parallel_ptr   ; impl_str = "mmult_para"  ;
+      } else if (strcmp(argv[i], "gemv" ) == 0) {
+        impl = impl_mmult_gemv_ptr ; impl_str = "mmult_gemv"  ;
+      } else if (strcmp(argv[i], "rec"  ) == 0) {
+        impl = impl_mmult_recursive_ptr; impl_str = "mmult_rec";
+      } else if (strcmp(argv[i], "batch") == 0) {
+        impl = impl_mmult_batch_ptr; impl_str = "mmult_batch" ;
+      } else if (strcmp(argv[i], "int8" ) == 0) {
+        impl = impl_mmult_int8_ptr ; impl_str = "mmult_int8"  ;
+        impl_prep = impl_mmult_int8_prep; impl_fini = impl_mmult_int8_fini;
+      } else if (strcmp(argv[i], "int8_avx2") == 0) {
+        impl = impl_mmult_int8_ptr ; impl_str = "mmult_int8_avx2";
+        impl_prep = impl_mmult_int8_prep_avx2; impl_fini = impl_mmult_int8_fini;
+      } else if (strcmp(argv[i], "fp16" ) == 0) {
+        impl = impl_mmult_fp16_ptr ; impl_str = "mmult_fp16"  ;
+        impl_prep = impl_mmult_fp16_prep; impl_fini = impl_mmult_half_fini;
+      } else if (strcmp(argv[i], "bf16" ) == 0) {
+        impl = impl_mmult_bf16_ptr ; impl_str = "mmult_bf16"  ;
+        impl_prep = impl_mmult_bf16_prep; impl_fini = impl_mmult_half_fini;
+      } else if (strcmp(argv[i], "auto" ) == 0) {
+        /* Resolved once the blocking is known */
+        impl = impl_mmult_opt_ptr  ; impl_str = "auto"        ;
+        auto_select = true;
+      } else if (strcmp(argv[i], "jit"  ) == 0) {
+        impl = impl_mmult_jit      ; impl_str = "mmult_jit"   ;
+        impl_prep = impl_mmult_jit_prep; impl_fini = impl_mmult_jit_fini;
+      } else if (strcmp(argv[i], "incr" ) == 0) {
+        impl = impl_mmult_incr     ; impl_str = "mmult_incr"  ;
+        impl_prep = impl_mmult_incr_prep; impl_fini = impl_mmult_incr_fini;
+        impl_step = impl_mmult_incr_tick;
+      } else if (strcmp(argv[i], "summa") == 0) {
+        impl = impl_mmult_summa    ; impl_str = "mmult_summa" ;
+        impl_prep = impl_mmult_summa_prep; impl_fini = impl_mmult_summa_fini;
+      } else if (strcmp(argv[i], "ooc"  ) == 0) {
+        impl = impl_mmult_ooc      ; impl_str = "mmult_ooc"   ;
+        impl_prep = impl_mmult_ooc_prep; impl_fini = impl_mmult_ooc_fini;
+      } else if (strcmp(argv[i], "spmm_naive") == 0) {
+        impl = impl_spmm_naive     ; impl_str = "spmm_naive"  ;
+        impl_prep = impl_spmm_prep; impl_fini = impl_spmm_fini;
+      } else if (strcmp(argv[i], "spmm_vec") == 0) {
+        impl = impl_spmm_vec       ; impl_str = "spmm_vec"    ;
+        impl_prep = impl_spmm_prep; impl_fini = impl_spmm_fini;
+      } else if (strcmp(argv[i], "spmm_para") == 0) {
+        impl = impl_spmm_para      ; impl_str = "spmm_para"   ;
+        impl_prep = impl_spmm_prep; impl_fini = impl_spmm_fini;
+      } else if (strcmp(argv[i], "syrk_naive") == 0) {
+        impl = impl_syrk_naive     ; impl_str = "syrk_naive"  ;
+      } else if (strcmp(argv[i], "syrk_para") == 0) {
+        impl = impl_syrk_para      ; impl_str = "syrk_para"   ;
+      } else if (strcmp(argv[i], "trmm_naive") == 0) {
+        impl = impl_trmm_naive     ; impl_str = "trmm_naive"  ;
+      } else if (strcmp(argv[i], "trmm_para") == 0) {
+        impl = impl_trmm_para      ; impl_str = "trmm_para"   ;
+      } else if (strcmp(argv[i], "trsm_naive") == 0) {
+        impl = impl_trsm_naive     ; impl_str = "trsm_naive"  ;
+      } else if (strcmp(argv[i], "trsm_para") == 0) {
+        impl = impl_trsm_para      ; impl_str = "trsm_para"   ;
       } else {
         impl = NULL                 ; impl_str = "unknown"     ;
       }
@@ -107,6 +264,7 @@ int main(int argc, char** argv)
     if (strcmp(argv[i], "-ar") == 0 || strcmp(argv[i], "--arows") == 0) {
         assert(++i < argc);
         mA_rows = atoi(argv[i]);
+        dims_set = true;
         continue;
     }
 
@@ -114,6 +272,7 @@ int main(int argc, char** argv)
     if (strcmp(argv[i], "-acbr") == 0 || strcmp(argv[i], "--acolsnbrows") == 0) {
         assert(++i < argc);
         mAB_cols_rows = atoi(argv[i]);
+        dims_set = true;
         continue;
     }
 
@@ -121,9 +280,273 @@ int main(int argc, char** argv)
     if (strcmp(argv[i], "-bc") == 0 || strcmp(argv[i], "--bcols") == 0) {
         assert(++i < argc);
         mB_cols = atoi(argv[i]);
+        dims_set = true;
         continue;
     }
 
+    /* Batched mode */
+    if (strcmp(argv[i], "--batch") == 0) {
+      assert (++i < argc);
+      batch = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--batch-layout") == 0) {
+      assert (++i < argc);
+      if      (strcmp(argv[i], "ptr"    ) == 0) { batch_layout = BATCH_LAYOUT_PTR;     }
+      else if (strcmp(argv[i], "strided") == 0) { batch_layout = BATCH_LAYOUT_STRIDED; }
+      else if (strcmp(argv[i], "compact") == 0) { batch_layout = BATCH_LAYOUT_COMPACT; }
+      else {
+        printf("\n");
+        printf("ERROR: Unknown batch layout \"%s\".\n", argv[i]);
+        exit(1);
+      }
+
+      continue;
+    }
+
+    /* Element type */
+    if (strcmp(argv[i], "--dtype") == 0) {
+      assert (++i < argc);
+      if      (strcmp(argv[i], "float"        ) == 0) { dtype = DTYPE_FLOAT;         }
+      else if (strcmp(argv[i], "double"       ) == 0) { dtype = DTYPE_DOUBLE;        }
+      else if (strcmp(argv[i], "complex"      ) == 0) { dtype = DTYPE_COMPLEX;       }
+      else if (strcmp(argv[i], "complex-split") == 0) { dtype = DTYPE_COMPLEX_SPLIT; }
+      else {
+        printf("\n");
+        printf("ERROR: Unknown data type \"%s\".\n", argv[i]);
+        exit(1);
+      }
+
+      continue;
+    }
+
+    /* GEMM interface */
+    if (strcmp(argv[i], "--alpha") == 0) {
+      assert (++i < argc);
+      alpha = atof(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--beta") == 0) {
+      assert (++i < argc);
+      beta = atof(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--trans-a") == 0) {
+      trans_a = true;
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--trans-b") == 0) {
+      trans_b = true;
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--lda") == 0) {
+      assert (++i < argc);
+      lda = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--ldb") == 0) {
+      assert (++i < argc);
+      ldb = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--ldc") == 0) {
+      assert (++i < argc);
+      ldc = atoi(argv[i]);
+
+      continue;
+    }
+
+    /* Operand layouts */
+    if (strcmp(argv[i], "--layout-a") == 0 || strcmp(argv[i], "--layout-b") == 0) {
+      layout_t* layout = (argv[i][9] == 'a') ? &layout_a : &layout_b;
+      assert (++i < argc);
+      if      (strcmp(argv[i], "row"  ) == 0) { *layout = LAYOUT_ROW;   }
+      else if (strcmp(argv[i], "col"  ) == 0) { *layout = LAYOUT_COL;   }
+      else if (strcmp(argv[i], "tiled") == 0) { *layout = LAYOUT_TILED; }
+      else {
+        printf("\n");
+        printf("ERROR: Unknown layout \"%s\".\n", argv[i]);
+        exit(1);
+      }
+
+      continue;
+    }
+
+    /* Fused epilogue */
+    if (strcmp(argv[i], "--bias") == 0) {
+      bias = true;
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--act") == 0) {
+      assert (++i < argc);
+      if      (strcmp(argv[i], "none") == 0) { act = ACT_NONE; }
+      else if (strcmp(argv[i], "relu") == 0) { act = ACT_RELU; }
+      else if (strcmp(argv[i], "gelu") == 0) { act = ACT_GELU; }
+      else {
+        printf("\n");
+        printf("ERROR: Unknown activation \"%s\".\n", argv[i]);
+        exit(1);
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--scale") == 0) {
+      assert (++i < argc);
+      scale = atof(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--convert") == 0) {
+      assert (++i < argc);
+      if      (strcmp(argv[i], "none") == 0) { cvt = CVT_NONE; }
+      else if (strcmp(argv[i], "bf16") == 0) { cvt = CVT_BF16; }
+      else if (strcmp(argv[i], "fp16") == 0) { cvt = CVT_FP16; }
+      else {
+        printf("\n");
+        printf("ERROR: Unknown conversion \"%s\".\n", argv[i]);
+        exit(1);
+      }
+
+      continue;
+    }
+
+    /* Sparse A */
+    if (strcmp(argv[i], "--density") == 0) {
+      assert (++i < argc);
+      density = atof(argv[i]);
+      if (density < 0.0 || density > 1.0) {
+        printf("ERROR: --density must be within [0, 1].\n");
+        exit(1);
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--structure") == 0) {
+      assert (++i < argc);
+      if      (strcmp(argv[i], "uniform" ) == 0) { structure = SPMM_UNIFORM;  }
+      else if (strcmp(argv[i], "banded"  ) == 0) { structure = SPMM_BANDED;   }
+      else if (strcmp(argv[i], "powerlaw") == 0) { structure = SPMM_POWERLAW; }
+      else {
+        printf("ERROR: Unknown sparsity structure \"%s\".\n", argv[i]);
+        exit(1);
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--crossover") == 0) {
+      crossover = true;
+
+      continue;
+    }
+
+    /* Incremental */
+    if (strcmp(argv[i], "--dirty-a") == 0 || strcmp(argv[i], "--dirty-b") == 0) {
+      double* dirty = (argv[i][8] == 'a') ? &dirty_a : &dirty_b;
+      assert (++i < argc);
+      *dirty = atof(argv[i]);
+      if (*dirty < 0.0 || *dirty > 1.0) {
+        printf("ERROR: --dirty-a and --dirty-b must be within [0, 1].\n");
+        exit(1);
+      }
+
+      continue;
+    }
+
+    /* Out-of-core */
+    if (strcmp(argv[i], "--mem-limit") == 0) {
+      assert (++i < argc);
+      mem_limit = mmult_ooc_parse_size(argv[i]);
+      if (mem_limit == 0) {
+        printf("ERROR: Cannot read --mem-limit \"%s\" (e.g. 512M, 2G).\n", argv[i]);
+        exit(1);
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--ooc-files") == 0) {
+      assert (i + 3 < argc);
+      ooc_files[0] = argv[++i];
+      ooc_files[1] = argv[++i];
+      ooc_files[2] = argv[++i];
+
+      continue;
+    }
+
+    /* Strassen cutoff */
+    if (strcmp(argv[i], "--cutoff") == 0) {
+      assert (++i < argc);
+      cutoff = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--strassen-crossover") == 0) {
+      strassen_sweep = true;
+
+      continue;
+    }
+
+    /* Blocking auto-tuner */
+    if (strcmp(argv[i], "--tune") == 0) {
+      tune = true;
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--tune-file") == 0) {
+      assert (++i < argc);
+      tune_file = argv[i];
+
+      continue;
+    }
+
+    /* Kernel selection */
+    if (strcmp(argv[i], "--calibrate") == 0) {
+      calibrate = true;
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--auto-file") == 0) {
+      assert (++i < argc);
+      auto_file = argv[i];
+
+      continue;
+    }
+
+    /* Shape suite */
+    if (strcmp(argv[i], "--suite") == 0) {
+      assert (++i < argc);
+      suite = argv[i];
+      if (!suite_valid_set(suite)) {
+        printf("ERROR: Unknown shape set \"%s\".\n", suite);
+        exit(1);
+      }
+
+      continue;
+    }
+
     /* Run parameterization */
     if (strcmp(argv[i], "--nruns") == 0) {
       assert (++i < argc);
@@ -162,6 +585,25 @@ int main(int argc, char** argv)
     }
   }
 
+  /* The crossover study picks its own implementations */
+  if (crossover && impl == NULL) {
+    impl = impl_spmm_para; impl_str = "spmm_para";
+  }
+
+  if (strassen_sweep && impl == NULL) {
+    impl = impl_mmult_strassen_ptr; impl_str = "mmult_strassen";
+  }
+
+  /* So does the shape suite (all of them) */
+  if (suite != NULL && impl == NULL) {
+    impl = impl_mmult_opt_ptr; impl_str = "mmult_opt";
+  }
+
+  /* The out-of-core files are always multiplied by -i ooc */
+  if (ooc_files[0] != NULL) {
+    impl = impl_mmult_ooc; impl_str = "mmult_ooc";
+  }
+
   if (help || impl == NULL) {
     if (!help) {
       if (impl_str != NULL) {
@@ -177,7 +619,9 @@ int main(int argc, char** argv)
     printf("  %s {-i | --impl} impl_str [Options]\n", argv[0]);
     printf("  \n");
     printf("  Required:\n");
-    printf("    -i    | --impl      Available implementations = {naive}\n");
+    printf("    -i    | --impl      Available implementations = {auto, naive, opt, strassen, vec, para, gemv, rec, batch, int8, int8_avx2, fp16, bf16,\n");
+    printf("                                                jit, incr, summa, ooc, spmm_naive, spmm_vec, spmm_para,\n");
+    printf("                                                syrk_naive, syrk_para, trmm_naive, trmm_para, trsm_naive, trsm_para}\n");
     printf("    \n");
     printf("  Options:\n");
     printf("    -h    | --help      Print this message\n");
@@ -186,6 +630,39 @@ int main(int argc, char** argv)
     printf("    -ar   | --arows      Size of input and output data (default = %d)\n", mA_rows);
     printf("    -abbr | --acolsnbrows      Size of input and output data (default = %d)\n", mAB_cols_rows);
     printf("    -bc   | --bcols      Size of input and output data (default = %d)\n", mB_cols);
+    printf("         --batch     Number of products for -i batch (default = %d)\n", BATCH_DEFAULT_COUNT);
+    printf("         --batch-layout  Batch layout = {ptr, strided, compact} (default = strided)\n");
+    printf("         --dtype     Element type = {float, double, complex, complex-split} (default = float);\n");
+    printf("                     double and complex support {naive, opt, vec, para}\n");
+    printf("         --alpha, --beta      C = alpha * op(A) * op(B) + beta * C (default = 1, 0)\n");
+    printf("         --trans-a, --trans-b Operand is stored transposed\n");
+    printf("         --lda, --ldb, --ldc  Leading dimensions (default = tightly packed)\n");
+    printf("         --bias      Fused epilogue: add a per-column bias\n");
+    printf("         --act       Fused epilogue: activation = {none, relu, gelu} (default = none)\n");
+    printf("         --scale     Fused epilogue: scale the result (default = 1)\n");
+    printf("         --convert   Fused epilogue: store as {none, bf16, fp16} (default = none)\n");
+    printf("         --layout-a, --layout-b  Operand storage = {row, col, tiled} (default = row)\n");
+    printf("                     The GEMM options are supported by -i opt only; naive also\n");
+    printf("                     takes transposes, leading dimensions, and row/col layouts\n");
+    printf("         --dirty-a, --dirty-b  Fraction of A rows / B columns -i incr recomputes per run\n");
+    printf("                     (default = %.2f, 0)\n", INCR_DEFAULT_DIRTY_A);
+    printf("                     summa runs one process per -n on a 2D grid over shared memory\n");
+    printf("                     syrk_* compute A * A^T (-bc = -ar); trmm_* and trsm_* multiply B by and\n");
+    printf("                     solve with a lower-triangular A (-acbr = -ar)\n");
+    printf("         --mem-limit Memory -i ooc may hold of the operands (default = %zuM)\n", OOC_DEFAULT_MEM_LIMIT >> 20);
+    printf("         --ooc-files A B C  Out-of-core product of the files A and B (generated if\n");
+    printf("                     missing) into C within --mem-limit, then exit\n");
+    printf("         --density   Keep this fraction of A nonzero (default = %.2f for spmm_*, dense otherwise)\n", SPMM_DEFAULT_DENSITY);
+    printf("         --structure Nonzero structure = {uniform, banded, powerlaw} (default = uniform)\n");
+    printf("         --crossover Time spmm_para against para over a sweep of densities and exit\n");
+    printf("         --calibrate Rebuild the decision table of -i auto\n");
+    printf("         --auto-file Per-host decision table (default = mmult_auto_<hostname>.cfg)\n");
+    printf("         --cutoff    Strassen recursion cutoff (default = %d)\n", cutoff);
+    printf("         --strassen-crossover  Time one Strassen level against vec on square sizes up to\n");
+    printf("                     the largest dimension, report the measured crossover, and exit\n");
+    printf("         --tune      Search the blocking parameters and save them to the tuning file\n");
+    printf("         --tune-file Per-host tuning file (default = mmult_tune_<hostname>.cfg)\n");
+    printf("         --suite     Time every implementation over a set of shapes = {all, square, near, skinny, dl}\n");
     printf("         --nruns     Number of runs to the implementation (default = %d)\n", nruns);
     printf("         --stdevs    Number of standard deviation to exclude outliers (default = %d)\n", nstdevs);
     printf("\n");
@@ -193,6 +670,145 @@ int main(int argc, char** argv)
     exit(help? 0 : 1);
   }
 
+  /* The automatic choice is among the plain float kernels */
+  if (auto_select && dtype != DTYPE_FLOAT) {
+    printf("\n");
+    printf("ERROR: \"-i auto\" supports --dtype float only.\n");
+    exit(1);
+  }
+
+  /* Double and complex variants of the generic implementations */
+  char dtype_impl_str[64];
+  if (dtype != DTYPE_FLOAT) {
+    bool        dbl    = (dtype == DTYPE_DOUBLE);
+    const char* prefix = dbl ? "dgemm" :
+                         (dtype == DTYPE_COMPLEX ? "cgemm" : "cgemm_split");
+    void* (*variant)(void* args) = NULL;
+
+    if      (impl == impl_mmult_naive_ptr) { variant = dbl ? impl_dgemm_naive : impl_cgemm_naive; }
+    else if (impl == impl_mmult_opt_ptr  ) { variant = dbl ? impl_dgemm_opt   : impl_cgemm_opt;   }
+    else if (impl == impl_vector_ptr     ) { variant = dbl ? impl_dgemm_vec   : impl_cgemm_vec;   }
+    else if (impl == impl_parallel_ptr   ) { variant = dbl ? impl_dgemm_para  : impl_cgemm_para;  }
+
+    if (variant == NULL) {
+      printf("\n");
+      printf("ERROR: \"%s\" has no %s variant.\n", impl_str, prefix);
+      exit(1);
+    }
+
+    /* mmult_<name> -> <prefix>_<name> */
+    snprintf(dtype_impl_str, sizeof(dtype_impl_str), "%s_%s",
+             prefix, impl_str + strlen("mmult_"));
+    impl     = variant;
+    impl_str = dtype_impl_str;
+    /* They allocate their own (double-sized) packing buffers */
+    impl_prep = NULL; impl_fini = NULL;
+  }
+
+  /* Only the reference and opt implement the full GEMM interface;
+     naive follows any strided (row or column-major) operand */
+  bool strided = trans_a || trans_b || lda != 0 || ldb != 0 || ldc != 0 ||
+                 layout_a == LAYOUT_COL || layout_b == LAYOUT_COL;
+  bool fused   = alpha != 1.0f || beta != 0.0f || bias || act != ACT_NONE ||
+                 scale != 1.0f || cvt != CVT_NONE ||
+                 layout_a == LAYOUT_TILED || layout_b == LAYOUT_TILED;
+  bool gemm    = strided || fused;
+  /* The JIT kernels bake in a ReLU, and nothing else */
+  bool relu    = act == ACT_RELU && alpha == 1.0f && beta == 0.0f && !bias &&
+                 scale == 1.0f && cvt == CVT_NONE &&
+                 layout_a != LAYOUT_TILED && layout_b != LAYOUT_TILED;
+  if ((fused && impl != impl_mmult_opt_ptr && !(relu && impl == impl_mmult_jit)) ||
+      (strided && impl != impl_mmult_opt_ptr && impl != impl_mmult_naive_ptr)) {
+    printf("\n");
+    printf("ERROR: alpha/beta, epilogues, and tiled operands require \"-i opt\"");
+    printf(" (\"-i jit\" takes --act relu);\n");
+    printf("       transposes, leading dimensions, and column-major operands\n");
+    printf("       require \"-i opt\" or \"-i naive\".\n");
+    exit(1);
+  }
+
+  if (auto_select && gemm) {
+    printf("\n");
+    printf("ERROR: \"-i auto\" computes plain C = A * B products only.\n");
+    exit(1);
+  }
+
+  /* Sparse operands are plain float products */
+  bool sparse = (impl == impl_spmm_naive || impl == impl_spmm_vec ||
+                 impl == impl_spmm_para);
+  if (sparse && density < 0.0) density = SPMM_DEFAULT_DENSITY;
+  if (density >= 0.0 && (gemm || dtype != DTYPE_FLOAT || impl == impl_mmult_batch_ptr)) {
+    printf("\n");
+    printf("ERROR: --density and the spmm_* implementations support float\n");
+    printf("       products without GEMM options or batching.\n");
+    exit(1);
+  }
+
+  /* Only the incremental implementation has dirty rows and columns */
+  bool incremental = (impl == impl_mmult_incr);
+  if ((dirty_a >= 0.0 || dirty_b >= 0.0) && !incremental) {
+    printf("\n");
+    printf("ERROR: --dirty-a and --dirty-b require \"-i incr\".\n");
+    exit(1);
+  }
+  if (incremental && dirty_a < 0.0 && dirty_b < 0.0) dirty_a = INCR_DEFAULT_DIRTY_A;
+  if (dirty_a < 0.0) dirty_a = 0.0;
+  if (dirty_b < 0.0) dirty_b = 0.0;
+
+  /* Only the out-of-core implementation has a memory budget */
+  bool out_of_core = (impl == impl_mmult_ooc);
+  if (mem_limit != 0 && !out_of_core) {
+    printf("\n");
+    printf("ERROR: --mem-limit requires \"-i ooc\".\n");
+    exit(1);
+  }
+  if (mem_limit == 0) mem_limit = OOC_DEFAULT_MEM_LIMIT;
+
+  /* Batched mode only makes sense for the batched implementation */
+  bool batched = (impl == impl_mmult_batch_ptr);
+  if (batch > 0 && !batched) {
+    printf("\n");
+    printf("ERROR: --batch requires \"-i batch\".\n");
+    exit(1);
+  }
+  if (batched) {
+    if (batch <= 0) batch = BATCH_DEFAULT_COUNT;
+    if (!dims_set) {
+      mA_rows = mAB_cols_rows = mB_cols = BATCH_DEFAULT_DIM;
+    }
+  }
+  size_t nbatch = batched ? batch : 1;
+
+  /* Structured routines: C = A * A^T is square, and L is square */
+  blas3_op_t blas3_op   = BLAS3_SYRK;
+  bool       structured = true;
+  if      (impl == impl_syrk_naive || impl == impl_syrk_para) { blas3_op = BLAS3_SYRK; }
+  else if (impl == impl_trmm_naive || impl == impl_trmm_para) { blas3_op = BLAS3_TRMM; }
+  else if (impl == impl_trsm_naive || impl == impl_trsm_para) { blas3_op = BLAS3_TRSM; }
+  else                                                        { structured = false;    }
+  if (structured && density >= 0.0) {
+    printf("\n");
+    printf("ERROR: --density does not apply to \"%s\".\n", impl_str);
+    exit(1);
+  }
+  if (structured) {
+    int* dim = (blas3_op == BLAS3_SYRK) ? &mB_cols : &mAB_cols_rows;
+    if (*dim != mA_rows) {
+      printf("Shape %d x %d x %d is not square where \"%s\" needs it; using %d x %d x %d\n\n",
+             mA_rows, mAB_cols_rows, mB_cols, impl_str,
+             mA_rows, (blas3_op == BLAS3_SYRK) ? mAB_cols_rows : mA_rows,
+                      (blas3_op == BLAS3_SYRK) ? mA_rows       : mB_cols);
+      *dim = mA_rows;
+    }
+  }
+
+  /* Skinny products are memory-bound; vec hands them to the GEMV paths */
+  if (impl == impl_vector_ptr && mmult_gemv_skinny(mA_rows, mB_cols)) {
+    printf("Shape %d x %d x %d is skinny; using \"mmult_gemv\" instead of \"%s\"\n\n",
+           mA_rows, mAB_cols_rows, mB_cols, impl_str);
+    impl = impl_mmult_gemv_ptr; impl_str = "mmult_gemv";
+  }
+
   /* Set our priority the highest */
   int nice_level = -20;
 
@@ -246,50 +862,281 @@ int main(int argc, char** argv)
 #endif
   printf("\n");
 
+  /* Blocking parameters */
+  cache_info_t cache_info;
+  blocking_t   blocking;
+  char         tune_path[256];
+
+  if (tune_file != NULL) {
+    snprintf(tune_path, sizeof(tune_path), "%s", tune_file);
+  } else {
+    tune_default_path(tune_path, sizeof(tune_path));
+  }
+
+  tune_cache_info(&cache_info);
+  printf("Setting up blocking parameters:\n");
+  printf("  * Cache sizes: L1d = %zu, L2 = %zu, L3 = %zu\n",
+         cache_info.l1d, cache_info.l2, cache_info.l3);
+
+  if (tune) {
+    printf("  * Running the blocking search:\n");
+    tune_search(&cache_info, &blocking, mA_rows, mB_cols, mAB_cols_rows);
+    printf("  * Saving to \"%s\" .... ", tune_path);
+    printf("%s\n", tune_save(tune_path, &cache_info, &blocking) ?
+                   "Succeeded" : "Failed");
+  } else if (tune_load(tune_path, &cache_info, &blocking)) {
+    printf("  * Loaded tuning file \"%s\"\n", tune_path);
+  } else {
+    printf("  * No valid tuning file \"%s\"; using the cache model\n", tune_path);
+    tune_model_blocking(&cache_info, &blocking);
+    mmult_opt_blocking(&blocking);
+  }
+  printf("  * Blocking: mc = %zu, kc = %zu, nc = %zu, mr = %zu, nr = %zu\n",
+         blocking.mc, blocking.kc, blocking.nc, blocking.mr, blocking.nr);
+  printf("\n");
+
+  /* Kernel selection from the per-host decision table */
+  char auto_impl_str[64];
+  if (auto_select) {
+    autosel_table_t* table = (autosel_table_t*)malloc(sizeof(autosel_table_t));
+    char             auto_path[256];
+
+    if (auto_file != NULL) {
+      snprintf(auto_path, sizeof(auto_path), "%s", auto_file);
+    } else {
+      autosel_default_path(auto_path, sizeof(auto_path));
+    }
+
+    printf("Selecting the kernel:\n");
+    if (!calibrate && autosel_load(auto_path, nthreads, table)) {
+      printf("  * Loaded decision table \"%s\"\n", auto_path);
+    } else {
+      if (!calibrate) {
+        printf("  * No valid decision table \"%s\" for %d thread(s)\n", auto_path, nthreads);
+      }
+      autosel_calibrate(table, &blocking, cutoff, nthreads, cpu);
+      printf("  * Saving to \"%s\" .... ", auto_path);
+      printf("%s\n", autosel_save(auto_path, table) ? "Succeeded" : "Failed");
+    }
+
+    const autosel_entry_t* e = autosel_lookup(table, mA_rows, mAB_cols_rows, mB_cols);
+    impl     = autosel_function(e->impl);
+    nthreads = e->nthreads;
+    if (impl == impl_mmult_opt_ptr) {
+      impl_prep = impl_mmult_opt_prep; impl_fini = impl_mmult_opt_fini;
+    }
+    snprintf(auto_impl_str, sizeof(auto_impl_str), "mmult_%s", e->impl);
+    impl_str = auto_impl_str;
+    printf("  * %d x %d x %d is nearest to %zu x %zu x %zu: \"%s\" with %d thread(s)\n",
+           mA_rows, mAB_cols_rows, mB_cols, e->m, e->k, e->n, impl_str, nthreads);
+    printf("\n");
+
+    free(table);
+  }
+
   /* Statistics */
   __DECLARE_STATS(nruns, nstdevs);
 
   /* Initialize Rand */
   srand(0xdeadbeef);
 
-  /* Datasets */
+  /* Shape suite */
+  if (suite != NULL) {
+    suite_run(suite, &blocking, cutoff, nthreads, cpu, nruns);
+    __DESTROY_STATS();
+    return 0;
+  }
+
+  /* Out-of-core product of files that need not fit in memory */
+  if (ooc_files[0] != NULL) {
+    bool ok = mmult_ooc_files(ooc_files[0], ooc_files[1], ooc_files[2],
+                              mA_rows, mAB_cols_rows, mB_cols, mem_limit,
+                              nthreads, cpu);
+    __DESTROY_STATS();
+    return ok ? 0 : 1;
+  }
+
+  /* Strassen crossover study */
+  if (strassen_sweep) {
+    int max_dim = mA_rows > mAB_cols_rows ? mA_rows : mAB_cols_rows;
+    max_dim     = max_dim > mB_cols       ? max_dim : mB_cols;
+    strassen_crossover(max_dim, nruns);
+    __DESTROY_STATS();
+    return 0;
+  }
+
+  /* Sparse-dense crossover study */
+  if (crossover) {
+    spmm_crossover(mA_rows, mAB_cols_rows, mB_cols, structure, nthreads, cpu, nruns);
+    __DESTROY_STATS();
+    return 0;
+  }
+
+  /* Stored shapes: op(A) is m x k, so a transposed A is stored k x m */
+  int a_rows = trans_a ? mAB_cols_rows : mA_rows;
+  int a_cols = trans_a ? mA_rows       : mAB_cols_rows;
+  int b_rows = trans_b ? mB_cols       : mAB_cols_rows;
+  int b_cols = trans_b ? mAB_cols_rows : mB_cols;
+  if (lda == 0) lda = a_cols;
+  if (ldb == 0) ldb = b_cols;
+  if (ldc == 0) ldc = mB_cols;
+  if (lda < a_cols || ldb < b_cols || ldc < mB_cols) {
+    printf("ERROR: Leading dimensions must be at least %d, %d, and %d.\n",
+           a_cols, b_cols, mB_cols);
+    exit(1);
+  }
+
+  /* Datasets (one matrix per operand, or a strided batch of them) */
+  int matrix_a_data_size = nbatch * a_rows * lda;
+  int matrix_b_data_size = nbatch * b_rows * ldb;
+  int data_size = nbatch * mA_rows * ldc;
+
+  /* Double and complex elements take two float words each; the
+     buffers below are sized and guarded in float words */
+  int words = (dtype == DTYPE_FLOAT) ? 1 : 2;
+
   /* Allocation and initialization */
-  float* src1   = __ALLOC_INIT_DATA(float, matrix_a_data_size * sizeof(float));
-  float* src2   = __ALLOC_INIT_DATA(float, matrix_b_data_size * sizeof(float));
-  float* ref    = __ALLOC_INIT_DATA(float, data_size + 4);
-  float* dest   = __ALLOC_DATA(float, data_size + 4);
+  float* src1   = __ALLOC_INIT_DATA(float, words * matrix_a_data_size);
+  float* src2   = __ALLOC_INIT_DATA(float, words * matrix_b_data_size);
+  float* ref    = __ALLOC_INIT_DATA(float, words * data_size + 4);
+  float* dest   = __ALLOC_DATA(float, words * data_size + 4);
+
+  /* Widen the random floats in place; complex data already has
+     random real and imaginary parts in both words */
+  if (dtype == DTYPE_DOUBLE) {
+    for (int i = matrix_a_data_size - 1; i >= 0; i--) ((double*)src1)[i] = src1[i];
+    for (int i = matrix_b_data_size - 1; i >= 0; i--) ((double*)src2)[i] = src2[i];
+  }
+
+  /* Sparse A: zero it in place, so dense implementations see the
+     same matrix and can be compared at the same density */
+  if (density >= 0.0) {
+    const char* structure_str[] = { "uniform", "banded", "power-law" };
+    printf("Sparsifying A to density %.4f (%s)\n\n", density, structure_str[structure]);
+    spmm_sparsify(src1, mA_rows, mAB_cols_rows, density, structure);
+  }
+
+  /* Structured routines: shape A and B so the GEMM reference applies */
+  if (structured) {
+    blas3_setup(blas3_op, src1, src2, mA_rows, mAB_cols_rows, mB_cols);
+  }
 
   /* Setting a guards, which is 0xdeadcafe.
      The guard should not change or be touched. */
-  __SET_FLOAT_GUARD(ref , data_size);
-  __SET_FLOAT_GUARD(dest, data_size);
+  __SET_FLOAT_GUARD(ref , words * data_size);
+  __SET_FLOAT_GUARD(dest, words * data_size);
+
+  /* GEMM mode: both sides start from the same C (beta reads it, and
+     padding past the columns must agree), restored before every run */
+  float*    c0        = NULL;
+  float*    bias_data = NULL;
+  uint16_t* ref_cvt   = NULL;
+  uint16_t* dest_cvt  = NULL;
+
+  if (gemm) {
+    memcpy(dest, ref, data_size * sizeof(float));
+    if (beta != 0.0f) {
+      c0 = __ALLOC_DATA(float, data_size);
+      memcpy(c0, ref, data_size * sizeof(float));
+    }
+    if (bias) {
+      bias_data = __ALLOC_INIT_DATA(float, mB_cols);
+    }
+    if (cvt != CVT_NONE) {
+      ref_cvt  = __ALLOC_DATA(uint16_t, data_size + 2);
+      dest_cvt = __ALLOC_DATA(uint16_t, data_size + 2);
+      memset(ref_cvt , 0, data_size * sizeof(uint16_t));
+      memset(dest_cvt, 0, data_size * sizeof(uint16_t));
+      __SET_GUARD(dest_cvt, data_size * sizeof(uint16_t));
+    }
+  }
+
+  epilogue_t epilogue;
+  epilogue_init(&epilogue);
+  epilogue.bias  = bias_data;
+  epilogue.act   = act;
+  epilogue.scale = scale;
+  epilogue.cvt   = cvt;
 
   /* Generate ref data */
   /* Arguments for the functions */
   args_t args_ref;
 
   args_ref.size     = data_size;
+  args_ref.dtype    = dtype;
   args_ref.output   = ref;
   args_ref.input_a  = src1;
   args_ref.input_b  = src2;
   args_ref.rowsA    = mA_rows;
   args_ref.colsA    = mAB_cols_rows;
   args_ref.colsB    = mB_cols;
+  args_ref.alpha    = alpha;
+  args_ref.beta     = beta;
+  args_ref.trans_a  = trans_a;
+  args_ref.trans_b  = trans_b;
+  args_ref.lda      = lda;
+  args_ref.ldb      = ldb;
+  args_ref.ldc      = ldc;
+  args_ref.layout_a = LAYOUT_ROW;
+  args_ref.layout_b = LAYOUT_ROW;
+  args_ref.epilogue = epilogue;
+  args_ref.epilogue.converted = ref_cvt;
+  args_ref.blocking = blocking;
+  args_ref.cutoff   = cutoff;
+  args_ref.dirty_a  = dirty_a;
+  args_ref.dirty_b  = dirty_b;
+  args_ref.mem_limit = mem_limit;
+  args_ref.state    = NULL;
+  args_ref.notes    = NULL;
 
   args_ref.cpu      = cpu;
   args_ref.nthreads = nthreads;
 
-  /* Running the reference function */
-  impl_ref(&args_ref);
+  /* Running the reference function, once per product of the batch */
+  for (size_t b = 0; b < nbatch; b++) {
+    args_ref.input_a = src1 + b * mA_rows * mAB_cols_rows;
+    args_ref.input_b = src2 + b * mAB_cols_rows * mB_cols;
+    args_ref.output  = ref  + b * mA_rows * mB_cols;
+    if      (dtype == DTYPE_FLOAT ) impl_ref(&args_ref);
+    else if (dtype == DTYPE_DOUBLE) impl_ref_double(&args_ref);
+    else                            impl_ref_complex(&args_ref);
+  }
+
+  /* TRSM solves L * X = B: the reference product L * B becomes the
+     right-hand side, and the B it came from the expected solution */
+  if (structured && blas3_op == BLAS3_TRSM) {
+    for (int i = 0; i < data_size; i++) {
+      float x = src2[i]; src2[i] = ref[i]; ref[i] = x;
+    }
+  }
 
   /* Execute the requested implementation */
   /* Arguments for the function */
   args_t args;
 
   args.size     = data_size;
+  args.dtype    = dtype;
   args.rowsA    = mA_rows;
   args.colsA    = mAB_cols_rows;
   args.colsB    = mB_cols;
+  args.alpha    = alpha;
+  args.beta     = beta;
+  args.trans_a  = trans_a;
+  args.trans_b  = trans_b;
+  args.lda      = lda;
+  args.ldb      = ldb;
+  args.ldc      = ldc;
+  args.layout_a = LAYOUT_ROW;
+  args.layout_b = LAYOUT_ROW;
+  args.epilogue = epilogue;
+  args.epilogue.converted = dest_cvt;
+  args.blocking = blocking;
+  args.cutoff   = cutoff;
+  args.dirty_a  = dirty_a;
+  args.dirty_b  = dirty_b;
+  args.mem_limit = mem_limit;
+  args.state    = NULL;
+  args.notes    = NULL;
   args.input_a  = src1;
   args.input_b  = src2;
   args.output   = dest;
@@ -297,22 +1144,202 @@ int main(int argc, char** argv)
   args.cpu      = cpu;
   args.nthreads = nthreads;
 
+  /* Arguments for the batched function */
+  batch_args_t bargs;
+  void*        impl_args = &args;
+
+  float*  compact_a = NULL;
+  float*  compact_b = NULL;
+  float*  compact_c = NULL;
+  float** ptrs      = NULL;
+
+  if (batched) {
+    bargs.layout   = batch_layout;
+    bargs.count    = nbatch;
+    bargs.m        = mA_rows;
+    bargs.k        = mAB_cols_rows;
+    bargs.n        = mB_cols;
+    bargs.a        = src1;
+    bargs.b        = src2;
+    bargs.c        = dest;
+    bargs.stride_a = mA_rows * mAB_cols_rows;
+    bargs.stride_b = mAB_cols_rows * mB_cols;
+    bargs.stride_c = mA_rows * mB_cols;
+    bargs.cpu      = cpu;
+    bargs.nthreads = nthreads;
+
+    printf("Preparing a batch of %zu (%d x %d x %d) products:\n",
+           nbatch, mA_rows, mAB_cols_rows, mB_cols);
+
+    if (batch_layout == BATCH_LAYOUT_PTR) {
+      printf("  * Layout: pointer array\n");
+      ptrs = (float**)malloc(3 * nbatch * sizeof(float*));
+      for (size_t b = 0; b < nbatch; b++) {
+        ptrs[0 * nbatch + b] = src1 + b * bargs.stride_a;
+        ptrs[1 * nbatch + b] = src2 + b * bargs.stride_b;
+        ptrs[2 * nbatch + b] = dest + b * bargs.stride_c;
+      }
+      bargs.a_array = (const float**)&ptrs[0 * nbatch];
+      bargs.b_array = (const float**)&ptrs[1 * nbatch];
+      bargs.c_array =                &ptrs[2 * nbatch];
+    } else if (batch_layout == BATCH_LAYOUT_STRIDED) {
+      printf("  * Layout: strided\n");
+    } else {
+      printf("  * Layout: compact (%d interleaved matrices)\n", BATCH_GROUP);
+      compact_a = __ALLOC_DATA(float, batch_compact_size(nbatch, mA_rows, mAB_cols_rows));
+      compact_b = __ALLOC_DATA(float, batch_compact_size(nbatch, mAB_cols_rows, mB_cols));
+      compact_c = __ALLOC_DATA(float, batch_compact_size(nbatch, mA_rows, mB_cols));
+
+      /* The conversion is timed on its own */
+      __SET_START_TIME();
+      batch_pack_compact(nbatch, mA_rows, mAB_cols_rows, src1, compact_a);
+      batch_pack_compact(nbatch, mAB_cols_rows, mB_cols, src2, compact_b);
+      __SET_END_TIME();
+      printf("  * Packing A and B took %" PRIu64 " ns\n", (uint64_t)__CALC_RUNTIME());
+
+      bargs.a = compact_a;
+      bargs.b = compact_b;
+      bargs.c = compact_c;
+    }
+    printf("\n");
+
+    impl_args = &bargs;
+  }
+
+  /* Operands in other layouts are converted from the row-major
+     originals (which the reference keeps using); each conversion is
+     timed on its own */
+  const char* layout_str[] = { "row-major", "column-major", "tiled" };
+  float*      conv_a       = NULL;
+  float*      conv_b       = NULL;
+
+  if (layout_a != LAYOUT_ROW || layout_b != LAYOUT_ROW) {
+    printf("Converting operands:\n");
+  }
+
+  if (layout_a != LAYOUT_ROW) {
+    size_t rs, cs;
+    layout_strides(LAYOUT_ROW, trans_a, mA_rows, mAB_cols_rows, lda, &rs, &cs);
+
+    if (layout_a == LAYOUT_COL) {
+      conv_a = __ALLOC_DATA(float, a_rows * a_cols);
+      __SET_START_TIME();
+      layout_transpose(a_rows, a_cols, src1, lda, conv_a, a_rows);
+      __SET_END_TIME();
+      args.lda = a_rows;
+    } else {
+      conv_a = __ALLOC_DATA(float, layout_tiled_size_a(mA_rows, mAB_cols_rows, &blocking));
+      __SET_START_TIME();
+      layout_tile_a(mA_rows, mAB_cols_rows, src1, rs, cs, &blocking, conv_a);
+      __SET_END_TIME();
+    }
+    printf("  * A to %s took %" PRIu64 " ns\n", layout_str[layout_a], (uint64_t)__CALC_RUNTIME());
+
+    args.input_a  = conv_a;
+    args.layout_a = layout_a;
+  }
+
+  if (layout_b != LAYOUT_ROW) {
+    size_t rs, cs;
+    layout_strides(LAYOUT_ROW, trans_b, mAB_cols_rows, mB_cols, ldb, &rs, &cs);
+
+    if (layout_b == LAYOUT_COL) {
+      conv_b = __ALLOC_DATA(float, b_rows * b_cols);
+      __SET_START_TIME();
+      layout_transpose(b_rows, b_cols, src2, ldb, conv_b, b_rows);
+      __SET_END_TIME();
+      args.ldb = b_rows;
+    } else {
+      conv_b = __ALLOC_DATA(float, layout_tiled_size_b(mAB_cols_rows, mB_cols, &blocking));
+      __SET_START_TIME();
+      layout_tile_b(mAB_cols_rows, mB_cols, src2, rs, cs, &blocking, conv_b);
+      __SET_END_TIME();
+    }
+    printf("  * B to %s took %" PRIu64 " ns\n", layout_str[layout_b], (uint64_t)__CALC_RUNTIME());
+
+    args.input_b  = conv_b;
+    args.layout_b = layout_b;
+  }
+
+  if (layout_a != LAYOUT_ROW || layout_b != LAYOUT_ROW) {
+    printf("\n");
+  }
+
   /* Start execution */
   printf("Running \"%s\" implementation:\n", impl_str);
 
+  if (impl_prep != NULL) {
+    __SET_START_TIME();
+    (*impl_prep)(&args);
+    __SET_END_TIME();
+    printf("  * Untimed preparation took %" PRIu64 " ns\n", (uint64_t)__CALC_RUNTIME());
+  }
+
   printf("  * Invoking the implementation %d times .... ", num_runs);
   for (int i = 0; i < num_runs; i++) {
+    if (c0 != NULL) {
+      memcpy(dest, c0, data_size * sizeof(float));
+    }
+    if (impl_step != NULL) {
+      (*impl_step)(&args);
+    }
     __SET_START_TIME();
-    (*impl)(&args);
+    (*impl)(impl_args);
     __SET_END_TIME();
     runtimes[i] = __CALC_RUNTIME();
   }
   printf("Finished\n");
 
+  /* Bring compact results back to the strided layout */
+  if (compact_c != NULL) {
+    batch_unpack_compact(nbatch, mA_rows, mB_cols, compact_c, dest);
+  }
+
+  /* Every incremental tick wrote new rows of A and columns of B: the
+     reference is the product of what they hold after the last one */
+  if (incremental) {
+    impl_ref(&args_ref);
+  }
+
   /* Verfication */
   printf("  * Verifying results .... ");
-  bool match = __CHECK_FLOAT_MATCH(ref, dest, data_size, 1e-5f);
-  bool guard = __CHECK_FLOAT_GUARD(     dest, data_size);
+  bool guard = __CHECK_FLOAT_GUARD(     dest, words * data_size);
+  double rel_err = __CALC_FLOAT_REL_ERROR(ref, dest, data_size);
+  if (dtype == DTYPE_DOUBLE) {
+    rel_err = __CALC_FLOAT_REL_ERROR(((double*)ref), ((double*)dest), data_size);
+  } else if (dtype != DTYPE_FLOAT) {
+    rel_err = __CALC_FLOAT_REL_ERROR(ref, dest, 2 * data_size);
+  }
+  if (cvt != CVT_NONE) {
+    /* Compare the 16-bit outputs, widened back to float */
+    float* ref_w  = __ALLOC_DATA(float, data_size);
+    float* dest_w = __ALLOC_DATA(float, data_size);
+    for (int i = 0; i < data_size; i++) {
+      ref_w [i] = (cvt == CVT_BF16) ? bf16_to_float(ref_cvt [i]) : fp16_to_float(ref_cvt [i]);
+      dest_w[i] = (cvt == CVT_BF16) ? bf16_to_float(dest_cvt[i]) : fp16_to_float(dest_cvt[i]);
+    }
+    rel_err = __CALC_FLOAT_REL_ERROR(ref_w, dest_w, data_size);
+    guard   = guard && __CHECK_GUARD(dest_cvt, data_size * sizeof(uint16_t));
+    free(ref_w);
+    free(dest_w);
+  }
+
+  /* The reference accumulates in double, so it is exact to well below
+     the tested rounding. A k-term (complex) dot product has a normwise
+     error of at most 2 k eps (the operands are nonnegative, so |A||B|
+     and |AB| have the same norm), plus one rounding to a 16-bit output
+     type on either side */
+  double eps   = (dtype == DTYPE_DOUBLE) ? 0x1p-53 : 0x1p-24;
+  double out   = (cvt == CVT_BF16) ? 0x1p-7 : (cvt == CVT_FP16) ? 0x1p-10 : 0.0;
+  double bound = 2.0 * mAB_cols_rows * eps + out;
+  bool   match = rel_err <= bound;
+  if (impl == impl_mmult_int8_ptr) {
+    /* Quantized results are checked against the quantization error bound */
+    match = mmult_int8_check(&args, ref);
+  } else if (impl == impl_mmult_fp16_ptr || impl == impl_mmult_bf16_ptr) {
+    /* So are 16-bit storage results, against the storage rounding bound */
+    match = mmult_half_check(&args, ref);
+  }
   if (match && guard) {
     printf("Success\n");
   } else if (!match && guard) {
@@ -322,6 +1349,11 @@ int main(int argc, char** argv)
   } else if(!match && !guard) {
     printf("Failed, and failed buffer overruns check\n");
   }
+  printf("  * Relative error (Frobenius) vs. ref = %.3e", rel_err);
+  if (impl != impl_mmult_int8_ptr && impl != impl_mmult_fp16_ptr && impl != impl_mmult_bf16_ptr) {
+    printf(" (bound %.3e)", bound);
+  }
+  printf("\n");
 
   /* Running analytics */
   uint64_t min     = -1;
@@ -400,6 +1432,41 @@ int main(int argc, char** argv)
   /* Display information */
   printf("  * Runtimes (%s): ", __PRINT_MATCH(match));
   printf(" %" PRIu64 " ns\n"  , avg                 );
+  /* A complex multiply-add is 8 real flops */
+  double flops = ((dtype == DTYPE_COMPLEX || dtype == DTYPE_COMPLEX_SPLIT) ? 8.0 : 2.0) *
+                 nbatch * mA_rows * mAB_cols_rows * mB_cols;
+  /* Sparse A, the structured routines, and the incremental updates *
+   * do far fewer flops than that: the GEMM count is only the        *
+   * dense-equivalent rate, and the useful rate follows below        */
+  printf("  * Throughput%s: %.2f GFLOP/s",
+         (sparse || structured || incremental) ? " (dense-equivalent)" : "",
+         flops / avg);
+  if (batched) {
+    printf(", %.1f ns per product", (double)avg / nbatch);
+  }
+  printf("\n");
+  /* Compulsory traffic: read A and B once, write C once */
+  double bytes = (double)words * sizeof(float) *
+                 (matrix_a_data_size + matrix_b_data_size + data_size);
+  printf("  * Bandwidth: %.2f GB/s (compulsory traffic)\n", bytes / avg);
+  if (sparse) {
+    /* Only the multiply-adds with a nonzero of A do useful work */
+    const csr_t* csr = (const csr_t*)args.state;
+    printf("  * Useful throughput: %.2f GFLOP/s (%zu nonzeros)\n",
+           2.0 * csr->nnz * mB_cols / avg, csr->nnz);
+  }
+  if (structured) {
+    /* The structure leaves out about half of the GEMM flops */
+    printf("  * Useful throughput: %.2f GFLOP/s (structure-aware flop count)\n",
+           blas3_flops(blas3_op, mA_rows, mAB_cols_rows, mB_cols) / avg);
+  }
+  if (incremental) {
+    /* Only the dirty rows and columns of C are recomputed */
+    const incr_t* incr = (const incr_t*)args.state;
+    double per_run = incr->flops / num_runs;
+    printf("  * Useful throughput: %.2f GFLOP/s (%.1f%% of the GEMM flops recomputed)\n",
+           per_run / avg, 100.0 * per_run / flops);
+  }
 
   /* Dump */
   printf("  * Dumping runtime informations:\n");
@@ -438,10 +1505,23 @@ int main(int argc, char** argv)
   printf("\n");
 
   /* Manage memory */
+  if (impl_fini != NULL) {
+    (*impl_fini)(&args);
+  }
   free(src1);
   free(src2);
   free(dest);
   free(ref);
+  free(compact_a);
+  free(compact_b);
+  free(compact_c);
+  free(ptrs);
+  free(c0);
+  free(conv_a);
+  free(conv_b);
+  free(bias_data);
+  free(ref_cvt);
+  free(dest_cvt);
 
   /* Finished with statistics */
   __DESTROY_STATS();
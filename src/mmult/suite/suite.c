@@ -0,0 +1,270 @@
+/* suite.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Shape-suite benchmark: every float implementation over a catalogue
+ *  of shapes, in one process.
+ *
+ *  The catalogue has four sets:
+ *    - square:  powers of two, 64 to 2048,
+ *    - near:    one below and one above the powers of two from 256 up,
+ *               which expose cache-set conflicts at the power-of-two
+ *               leading dimensions,
+ *    - skinny:  tall-skinny and short-wide products, down to GEMV,
+ *    - dl:      layer shapes of common networks (transformer projections
+ *               and feed-forward layers, im2col'd ResNet-50 convolutions,
+ *               an LSTM cell).
+ *  Every shape is checked against the reference, then each implementation
+ *  is timed for up to nruns runs or SUITE_BUDGET_NS, whichever ends first;
+ *  the best run is reported. Every shape gets its own table, followed by
+ *  the notes the prep hooks print, and the GFLOP/s of all shapes are
+ *  written to "mmult_suite.csv" for plotting.
+ */
+
+/* Set features         */
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/ref.h"
+#include "impl/naive.h"
+#include "impl/opt.h"
+#include "impl/strassen.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+#include "impl/gemv.h"
+#include "impl/recursive.h"
+#include "impl/int8.h"
+#include "impl/half.h"
+#include "impl/jit.h"
+#include "impl/epilogue.h"
+#include "suite.h"
+
+/* One shape of the catalogue */
+typedef struct {
+  const char* set;
+  const char* name;
+  size_t      m, k, n;
+} suite_shape_t;
+
+static const suite_shape_t shapes[] = {
+  { "square", "pow2 64"            ,    64,    64,    64 },
+  { "square", "pow2 128"           ,   128,   128,   128 },
+  { "square", "pow2 256"           ,   256,   256,   256 },
+  { "square", "pow2 512"           ,   512,   512,   512 },
+  { "square", "pow2 1024"          ,  1024,  1024,  1024 },
+  { "square", "pow2 2048"          ,  2048,  2048,  2048 },
+  { "near"  , "pow2 256 - 1"       ,   255,   255,   255 },
+  { "near"  , "pow2 256 + 1"       ,   257,   257,   257 },
+  { "near"  , "pow2 512 - 1"       ,   511,   511,   511 },
+  { "near"  , "pow2 512 + 1"       ,   513,   513,   513 },
+  { "near"  , "pow2 1024 - 1"      ,  1023,  1023,  1023 },
+  { "near"  , "pow2 1024 + 1"      ,  1025,  1025,  1025 },
+  { "near"  , "pow2 2048 - 1"      ,  2047,  2047,  2047 },
+  { "near"  , "pow2 2048 + 1"      ,  2049,  2049,  2049 },
+  { "skinny", "tall x 64"          , 16384,    64,    64 },
+  { "skinny", "tall x 16"          ,  4096,  4096,    16 },
+  { "skinny", "wide 16 x"          ,    16,  4096,  4096 },
+  { "skinny", "inner 16"           ,  2048,    16,  2048 },
+  { "skinny", "GEMV (n = 1)"       ,  4096,  4096,     1 },
+  { "skinny", "GEMV (m = 1)"       ,     1,  4096,  4096 },
+  { "dl"    , "BERT-base QKV"      ,   512,   768,  2304 },
+  { "dl"    , "BERT-base attn out" ,   512,   768,   768 },
+  { "dl"    , "BERT-base FFN up"   ,   512,   768,  3072 },
+  { "dl"    , "BERT-base FFN down" ,   512,  3072,   768 },
+  { "dl"    , "GPT-2 FFN up (b=1)" ,     1,   768,  3072 },
+  { "dl"    , "ResNet-50 conv2_x"  ,  3136,   576,    64 },
+  { "dl"    , "ResNet-50 conv3_x"  ,   784,  1152,   128 },
+  { "dl"    , "ResNet-50 conv4_x"  ,   196,  2304,   256 },
+  { "dl"    , "ResNet-50 conv5_x"  ,    49,  4608,   512 },
+  { "dl"    , "ResNet-50 fc"       ,    32,  2048,  1000 },
+  { "dl"    , "LSTM-1024 gates"    ,    64,  2048,  4096 },
+};
+static const int nshapes = sizeof(shapes) / sizeof(shapes[0]);
+
+/* The float implementations of the driver (batch, spmm, and summa *
+ * need their own inputs or processes, so they are left out)       */
+typedef struct {
+  const char* name;
+  void*     (*impl)(void* args);
+  void*     (*prep)(void* args);
+  void*     (*fini)(void* args);
+  bool      (*check)(const args_t* args, const float* ref);
+} suite_impl_t;
+
+static const suite_impl_t impls[] = {
+  { "naive"    , impl_mmult_naive    , NULL                     , NULL                , NULL             },
+  { "opt"      , impl_mmult_opt      , impl_mmult_opt_prep      , impl_mmult_opt_fini , NULL             },
+  { "strassen" , impl_mmult_strassen , NULL                     , NULL                , NULL             },
+  { "vec"      , impl_vector         , NULL                     , NULL                , NULL             },
+  { "para"     , impl_parallel       , NULL                     , NULL                , NULL             },
+  { "gemv"     , impl_mmult_gemv     , NULL                     , NULL                , NULL             },
+  { "rec"      , impl_mmult_recursive, NULL                     , NULL                , NULL             },
+  { "jit"      , impl_mmult_jit      , impl_mmult_jit_prep      , impl_mmult_jit_fini , NULL             },
+  { "int8"     , impl_mmult_int8     , impl_mmult_int8_prep     , impl_mmult_int8_fini, mmult_int8_check },
+  { "int8_avx2", impl_mmult_int8     , impl_mmult_int8_prep_avx2, impl_mmult_int8_fini, mmult_int8_check },
+  { "fp16"     , impl_mmult_fp16     , impl_mmult_fp16_prep     , impl_mmult_half_fini, mmult_half_check },
+  { "bf16"     , impl_mmult_bf16     , impl_mmult_bf16_prep     , impl_mmult_half_fini, mmult_half_check },
+};
+static const int nimpls = sizeof(impls) / sizeof(impls[0]);
+
+static bool in_set(const char* set, const suite_shape_t* shape)
+{
+  return strcmp(set, "all") == 0 || strcmp(set, shape->set) == 0;
+}
+
+bool suite_valid_set(const char* set)
+{
+  if (strcmp(set, "all") == 0) return true;
+  for (int s = 0; s < nshapes; s++) {
+    if (strcmp(set, shapes[s].set) == 0) return true;
+  }
+  return false;
+}
+
+/* Plain C = A * B arguments */
+static void suite_args(args_t* args, float* A, float* B, float* C,
+                       const suite_shape_t* shape, const blocking_t* blocking,
+                       int cutoff, int nthreads, int cpu)
+{
+  memset(args, 0, sizeof(*args));
+  args->input_a  = A;
+  args->input_b  = B;
+  args->output   = C;
+  args->rowsA    = shape->m;
+  args->colsA    = shape->k;
+  args->colsB    = shape->n;
+  args->size     = shape->m * shape->n;
+  args->dtype    = DTYPE_FLOAT;
+  args->alpha    = 1.0f;
+  args->beta     = 0.0f;
+  args->layout_a = LAYOUT_ROW;
+  args->layout_b = LAYOUT_ROW;
+  epilogue_init(&args->epilogue);
+  args->blocking = *blocking;
+  args->cutoff   = cutoff;
+  args->state    = NULL;
+  args->notes    = NULL;
+  args->cpu      = cpu;
+  args->nthreads = nthreads;
+}
+
+void suite_run(const char* set, const blocking_t* blocking,
+               int cutoff, int nthreads, int cpu, int nruns)
+{
+  struct timespec ts;
+  struct timespec te;
+
+  FILE* csv = fopen("mmult_suite.csv", "w");
+  if (csv != NULL) {
+    fprintf(csv, "set,shape,m,k,n");
+    for (int i = 0; i < nimpls; i++) {
+      fprintf(csv, ",%s", impls[i].name);
+    }
+    fprintf(csv, "\n");
+  }
+
+  printf("Running the \"%s\" shape suite (%d thread(s), up to %d runs or %.1f s each):\n\n",
+         set, nthreads, nruns, SUITE_BUDGET_NS / 1e9);
+
+  for (int s = 0; s < nshapes; s++) {
+    const suite_shape_t* shape = &shapes[s];
+    if (!in_set(set, shape)) continue;
+
+    size_t m = shape->m, k = shape->k, n = shape->n;
+    double flops = 2.0 * m * n * k;
+
+    float* A   = __ALLOC_INIT_DATA(float, m * k);
+    float* B   = __ALLOC_INIT_DATA(float, k * n);
+    float* ref = __ALLOC_DATA(float, m * n);
+    float* C   = __ALLOC_DATA(float, m * n + 4);
+
+    args_t args;
+    suite_args(&args, A, B, ref, shape, blocking, cutoff, nthreads, cpu);
+    impl_ref(&args);
+    args.output = C;
+
+    /* Notes of the prep hooks go under the table, not between its rows */
+    char*  notes     = NULL;
+    size_t notes_len = 0;
+    args.notes = open_memstream(&notes, &notes_len);
+
+    printf("%s (%s): %zu x %zu x %zu\n", shape->name, shape->set, m, k, n);
+    printf("  %-10s %14s %10s %11s %s\n", "impl", "best (ns)", "GFLOP/s", "rel. error", "check");
+    if (csv != NULL) {
+      fprintf(csv, "%s,%s,%zu,%zu,%zu", shape->set, shape->name, m, k, n);
+    }
+
+    for (int i = 0; i < nimpls; i++) {
+      const suite_impl_t* im = &impls[i];
+
+      memset(C, 0, m * n * sizeof(float));
+      __SET_FLOAT_GUARD(C, m * n);
+
+      if (im->prep != NULL) (*im->prep)(&args);
+
+      uint64_t best  = UINT64_MAX;
+      uint64_t spent = 0;
+      for (int r = 0; r < nruns && spent < SUITE_BUDGET_NS; r++) {
+        __SET_START_TIME();
+        (*im->impl)(&args);
+        __SET_END_TIME();
+
+        uint64_t t = __CALC_RUNTIME();
+        spent += t;
+        if (t < best) best = t;
+      }
+
+      /* Same criteria as the single-shape driver */
+      double rel_err = __CALC_FLOAT_REL_ERROR(ref, C, m * n);
+      bool   match   = (im->check != NULL) ? (*im->check)(&args, ref)
+                                           : rel_err <= 2.0 * k * 0x1p-24;
+      bool   guard   = __CHECK_FLOAT_GUARD(C, m * n);
+
+      if (im->fini != NULL) (*im->fini)(&args);
+
+      printf("  %-10s %14" PRIu64 " %10.2f %11.3e %s\n", im->name, best,
+             flops / best, rel_err,
+             (match && guard) ? "ok" : (guard ? "FAIL" : "FAIL (overrun)"));
+      if (csv != NULL) {
+        fprintf(csv, ",%.3f", flops / best);
+      }
+    }
+
+    if (args.notes != NULL) {
+      fclose(args.notes);
+      args.notes = NULL;
+      printf("%s", notes);
+    }
+    free(notes);
+
+    printf("\n");
+    if (csv != NULL) {
+      fprintf(csv, "\n");
+    }
+
+    free(A);
+    free(B);
+    free(ref);
+    free(C);
+  }
+
+  if (csv != NULL) {
+    fclose(csv);
+    printf("GFLOP/s of every shape and implementation written to \"mmult_suite.csv\"\n\n");
+  }
+}
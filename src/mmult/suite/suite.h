@@ -0,0 +1,26 @@
+/* suite.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the shape-suite benchmark of the mmult implementations.
+ */
+
+#ifndef __SUITE_SUITE_H_
+#define __SUITE_SUITE_H_
+
+/* Standard C includes */
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Time spent per implementation and shape, in ns (runs are capped by it) */
+#define SUITE_BUDGET_NS 500000000llu
+
+/* Function declarations */
+bool suite_valid_set (const char* set);
+void suite_run       (const char* set, const blocking_t* blocking,
+                      int cutoff, int nthreads, int cpu, int nruns);
+
+#endif //__SUITE_SUITE_H_
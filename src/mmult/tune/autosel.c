@@ -0,0 +1,270 @@
+/* autosel.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Shape-driven kernel selection for -i auto.
+ *
+ *  A calibration run times the candidate kernels (naive, opt, Strassen,
+ *  vec, GEMV, and para at 1, 2, 4, ... threads up to -n) on every point
+ *  of a small (m, k, n) grid and records the fastest per point in a
+ *  per-host decision table, next to the blocking tuning file. A request
+ *  is then served by the grid point nearest to its shape in log space,
+ *  since the kernels' relative speed depends on the orders of magnitude
+ *  of the dimensions (and on which of them are tiny), not on their
+ *  exact values. Skinny shapes (see mmult_gemv_skinny) are served only
+ *  by points GEMV won, so they never cross the skinny boundary.
+ *
+ *  Candidates are timed from the one expected to be fastest; one that is
+ *  AUTOSEL_PRUNE times slower than the best so far on its first run is
+ *  dropped, which keeps the slow scalar kernels from dominating the
+ *  calibration time on the large points.
+ */
+
+/* Set features         */
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/naive.h"
+#include "impl/opt.h"
+#include "impl/strassen.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+#include "impl/gemv.h"
+#include "impl/epilogue.h"
+#include "autosel.h"
+
+/* Candidates, most promising first; para is tried per thread count */
+typedef struct {
+  const char* name;
+  void*     (*impl)(void* args);
+} autosel_cand_t;
+
+static const autosel_cand_t cands[] = {
+  { "vec"     , impl_vector         },
+  { "gemv"    , impl_mmult_gemv     },
+  { "para"    , impl_parallel       },
+  { "opt"     , impl_mmult_opt      },
+  { "strassen", impl_mmult_strassen },
+  { "naive"   , impl_mmult_naive    },
+};
+static const int ncands = sizeof(cands) / sizeof(cands[0]);
+
+void* (*autosel_function(const char* impl))(void* args)
+{
+  for (int c = 0; c < ncands; c++) {
+    if (strcmp(impl, cands[c].name) == 0) return cands[c].impl;
+  }
+  return NULL;
+}
+
+void autosel_default_path(char* path, size_t len)
+{
+  char host[128];
+
+  if (gethostname(host, sizeof(host)) != 0) {
+    strcpy(host, "unknown");
+  }
+  host[sizeof(host) - 1] = '\0';
+
+  snprintf(path, len, "mmult_auto_%s.cfg", host);
+}
+
+bool autosel_load(const char* path, int max_threads, autosel_table_t* table)
+{
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) return false;
+
+  table->max_threads = 0;
+  table->nentries    = 0;
+
+  char line[256];
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    autosel_entry_t e;
+    int             threads;
+
+    if (line[0] == '#') continue;
+    if (sscanf(line, "threads=%d", &threads) == 1) {
+      table->max_threads = threads;
+      continue;
+    }
+    if (sscanf(line, "%zu %zu %zu %15s %d %" SCNu64,
+               &e.m, &e.k, &e.n, e.impl, &e.nthreads, &e.ns) != 6) continue;
+    if (autosel_function(e.impl) == NULL) continue;
+    if (table->nentries < AUTOSEL_ENTRIES) {
+      table->entries[table->nentries++] = e;
+    }
+  }
+  fclose(fp);
+
+  /* A table calibrated for a different thread budget is stale */
+  return table->nentries > 0 && table->max_threads == max_threads;
+}
+
+bool autosel_save(const char* path, const autosel_table_t* table)
+{
+  FILE* fp = fopen(path, "w");
+  if (fp == NULL) return false;
+
+  fprintf(fp, "# mmult kernel decision table, written by -i auto --calibrate\n");
+  fprintf(fp, "threads=%d\n", table->max_threads);
+  fprintf(fp, "# m k n impl nthreads ns\n");
+  for (int i = 0; i < table->nentries; i++) {
+    const autosel_entry_t* e = &table->entries[i];
+    fprintf(fp, "%zu %zu %zu %s %d %" PRIu64 "\n",
+            e->m, e->k, e->n, e->impl, e->nthreads, e->ns);
+  }
+  fclose(fp);
+
+  return true;
+}
+
+/* Best-of-reps runtime of one candidate; stops after the first run if *
+ * that is already more than 'limit' ns                                 */
+static uint64_t time_candidate(void* (*impl)(void*), args_t* args,
+                               int reps, uint64_t limit)
+{
+  struct timespec ts;
+  struct timespec te;
+  uint64_t        best = UINT64_MAX;
+
+  for (int r = 0; r < reps; r++) {
+    __SET_START_TIME();
+    (*impl)(args);
+    __SET_END_TIME();
+
+    uint64_t t = __CALC_RUNTIME();
+    if (t < best) best = t;
+    if (t > limit) break;
+  }
+
+  return best;
+}
+
+void autosel_calibrate(autosel_table_t* table, const blocking_t* blocking,
+                       int cutoff, int max_threads, int cpu)
+{
+  static const size_t grid[] = AUTOSEL_GRID;
+  const size_t        big    = grid[AUTOSEL_GRID_SIZE - 1];
+
+  float* A = __ALLOC_INIT_DATA(float, big * big);
+  float* B = __ALLOC_INIT_DATA(float, big * big);
+  float* C = __ALLOC_DATA(float, big * big);
+
+  table->max_threads = max_threads < 1 ? 1 : max_threads;
+  table->nentries    = 0;
+
+  printf("  * Calibrating %d shapes:\n", AUTOSEL_ENTRIES);
+
+  for (int im = 0; im < AUTOSEL_GRID_SIZE; im++)
+  for (int ik = 0; ik < AUTOSEL_GRID_SIZE; ik++)
+  for (int in = 0; in < AUTOSEL_GRID_SIZE; in++) {
+    args_t args;
+    memset(&args, 0, sizeof(args));
+    args.input_a  = A;
+    args.input_b  = B;
+    args.output   = C;
+    args.rowsA    = grid[im];
+    args.colsA    = grid[ik];
+    args.colsB    = grid[in];
+    args.size     = grid[im] * grid[in];
+    args.dtype    = DTYPE_FLOAT;
+    args.alpha    = 1.0f;
+    args.layout_a = LAYOUT_ROW;
+    args.layout_b = LAYOUT_ROW;
+    epilogue_init(&args.epilogue);
+    args.blocking = *blocking;
+    args.cutoff   = cutoff;
+    args.cpu      = cpu;
+    args.nthreads = 1;
+
+    autosel_entry_t best = { grid[im], grid[ik], grid[in], "", 1, UINT64_MAX };
+
+    for (int c = 0; c < ncands; c++) {
+      /* Outside its shapes, gemv is vec under another name */
+      if (cands[c].impl == impl_mmult_gemv && !mmult_gemv_skinny(grid[im], grid[in])) {
+        continue;
+      }
+
+      bool para = (cands[c].impl == impl_parallel);
+      for (int t = 1; t <= (para ? table->max_threads : 1); t *= 2) {
+        args.nthreads = t;
+
+        uint64_t limit = (best.ns == UINT64_MAX) ? UINT64_MAX : AUTOSEL_PRUNE * best.ns;
+        uint64_t ns    = time_candidate(cands[c].impl, &args, AUTOSEL_REPS, limit);
+
+        if (ns < best.ns) {
+          best.ns       = ns;
+          best.nthreads = t;
+          snprintf(best.impl, sizeof(best.impl), "%s", cands[c].name);
+        }
+      }
+    }
+
+    printf("    + %4zu x %4zu x %4zu -> %-8s (%d thread(s)) %12" PRIu64 " ns\n",
+           best.m, best.k, best.n, best.impl, best.nthreads, best.ns);
+    table->entries[table->nentries++] = best;
+  }
+
+  free(A);
+  free(B);
+  free(C);
+}
+
+/* Distance in orders of magnitude */
+static double log_distance(size_t a, size_t b)
+{
+  return fabs(log2((double)a) - log2((double)b));
+}
+
+/* Nearest entry, among the GEMV ones only if 'gemv' is set */
+static const autosel_entry_t* nearest(const autosel_table_t* table,
+                                      size_t m, size_t k, size_t n, bool gemv)
+{
+  const autosel_entry_t* best   = NULL;
+  double                 best_d = INFINITY;
+
+  for (int i = 0; i < table->nentries; i++) {
+    const autosel_entry_t* e = &table->entries[i];
+    if (gemv && strcmp(e->impl, "gemv") != 0) continue;
+
+    double d = log_distance(m, e->m) + log_distance(k, e->k) + log_distance(n, e->n);
+    if (d < best_d) {
+      best_d = d;
+      best   = e;
+    }
+  }
+
+  return best;
+}
+
+const autosel_entry_t* autosel_lookup(const autosel_table_t* table,
+                                      size_t m, size_t k, size_t n)
+{
+  /* Skinny shapes stay on the GEMV side of the boundary: the nearest *
+   * point in log space may not (300 x 200 x 5 is nearest to          *
+   * 128 x 128 x 16, where para can win), so they take the nearest    *
+   * point GEMV won, as vec hands them to GEMV too                    */
+  if (mmult_gemv_skinny(m, n)) {
+    const autosel_entry_t* e = nearest(table, m, k, n, true);
+    if (e != NULL) return e;
+  }
+
+  return nearest(table, m, k, n, false);
+}
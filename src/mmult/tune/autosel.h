@@ -0,0 +1,58 @@
+/* autosel.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the shape-driven kernel selection (-i auto).
+ */
+
+#ifndef __TUNE_AUTOSEL_H_
+#define __TUNE_AUTOSEL_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Calibration grid: every (m, k, n) with each dimension in this list */
+#define AUTOSEL_GRID      { 1, 16, 128, 1024 }
+#define AUTOSEL_GRID_SIZE 4
+#define AUTOSEL_ENTRIES   (AUTOSEL_GRID_SIZE * AUTOSEL_GRID_SIZE * AUTOSEL_GRID_SIZE)
+
+/* Calibration repetitions, and how much slower than the best so far *
+ * a candidate may be on its first run before it is dropped          */
+#define AUTOSEL_REPS      3
+#define AUTOSEL_PRUNE     4
+
+/* Fastest kernel of one grid point */
+typedef struct {
+  size_t   m, k, n;
+  char     impl[16];
+  int      nthreads;
+  uint64_t ns;
+} autosel_entry_t;
+
+/* Per-host decision table */
+typedef struct {
+  int             max_threads;  // -n it was calibrated with
+  int             nentries;
+  autosel_entry_t entries[AUTOSEL_ENTRIES];
+} autosel_table_t;
+
+/* Function declarations */
+void                   autosel_default_path (char* path, size_t len);
+bool                   autosel_load         (const char* path, int max_threads,
+                                             autosel_table_t* table);
+bool                   autosel_save         (const char* path,
+                                             const autosel_table_t* table);
+void                   autosel_calibrate    (autosel_table_t* table,
+                                             const blocking_t* blocking,
+                                             int cutoff, int max_threads, int cpu);
+const autosel_entry_t* autosel_lookup       (const autosel_table_t* table,
+                                             size_t m, size_t k, size_t n);
+void*                (*autosel_function     (const char* impl))(void* args);
+
+#endif //__TUNE_AUTOSEL_H_
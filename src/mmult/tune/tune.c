@@ -0,0 +1,340 @@
+/* tune.c
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ *  Auto-tuner for the blocking parameters of the opt kernel.
+ *
+ *  The starting point is an analytical model derived from the cache
+ *  sizes reported by the kernel under /sys/devices/system/cpu/cpu0/cache:
+ *    - a kc x nr sliver of B plus an mr x kc sliver of A fill half of L1,
+ *    - an mc x kc block of A fills half of L2,
+ *    - a kc x nc panel of B fills half of L3.
+ *  A short coordinate search then times the kernel around that point:
+ *  first the register tile (mr, nr), then kc, mc, and nc. The winner is
+ *  written to a per-host tuning file that later runs load.
+ */
+
+/* Set features         */
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/opt.h"
+#include "tune.h"
+
+/* Fallback cache sizes when sysfs is not available */
+#define TUNE_FALLBACK_L1D (  32 * 1024)
+#define TUNE_FALLBACK_L2  ( 256 * 1024)
+#define TUNE_FALLBACK_L3  (8192 * 1024)
+
+/* Largest problem the search is timed on, and repetitions per point */
+#define TUNE_MAX_DIM 512
+#define TUNE_REPS    3
+
+/* Read a size such as "48K" or "2048K" from a sysfs file */
+static size_t read_cache_size(const char* path)
+{
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) return 0;
+
+  unsigned long value = 0;
+  char          unit  = 0;
+  int n = fscanf(fp, "%lu%c", &value, &unit);
+  fclose(fp);
+
+  if (n < 1) return 0;
+  if (unit == 'K') value *= 1024;
+  if (unit == 'M') value *= 1024 * 1024;
+
+  return value;
+}
+
+void tune_cache_info(cache_info_t* info)
+{
+  info->l1d = 0;
+  info->l2  = 0;
+  info->l3  = 0;
+
+#if !defined(__APPLE__)
+  for (int idx = 0; ; idx++) {
+    char path[256];
+    char type[32];
+    int  level = 0;
+
+    /*   -> Cache level */
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu0/cache/index%d/level", idx);
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL) break;
+    int __attribute__((unused)) ret = fscanf(fp, "%d", &level);
+    fclose(fp);
+
+    /*   -> Cache type (skip instruction caches) */
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu0/cache/index%d/type", idx);
+    fp = fopen(path, "r");
+    if (fp == NULL) break;
+    ret = fscanf(fp, "%31s", type);
+    fclose(fp);
+
+    if (strcmp(type, "Instruction") == 0) continue;
+
+    /*   -> Cache size */
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu0/cache/index%d/size", idx);
+    size_t size = read_cache_size(path);
+
+    if      (level == 1) info->l1d = size;
+    else if (level == 2) info->l2  = size;
+    else if (level == 3) info->l3  = size;
+  }
+#endif
+
+  if (info->l1d == 0) info->l1d = TUNE_FALLBACK_L1D;
+  if (info->l2  == 0) info->l2  = TUNE_FALLBACK_L2;
+  if (info->l3  == 0) info->l3  = info->l2 * 4 > TUNE_FALLBACK_L3 ?
+                                  info->l2 * 4 : TUNE_FALLBACK_L3;
+}
+
+void tune_default_path(char* path, size_t len)
+{
+  char host[128];
+
+  if (gethostname(host, sizeof(host)) != 0) {
+    strcpy(host, "unknown");
+  }
+  host[sizeof(host) - 1] = '\0';
+
+  snprintf(path, len, "mmult_tune_%s.cfg", host);
+}
+
+/* Round x down to a multiple of m, but never below m */
+static size_t round_down(size_t x, size_t m)
+{
+  x = (x / m) * m;
+  return x < m ? m : x;
+}
+
+void tune_model_blocking(const cache_info_t* info, blocking_t* blk)
+{
+  const size_t fsz = sizeof(float);
+
+  blk->mr = OPT_DEFAULT_MR;
+  blk->nr = OPT_DEFAULT_NR;
+
+  blk->kc = round_down((info->l1d / 2) / ((blk->mr + blk->nr) * fsz), 8);
+  blk->mc = round_down((info->l2  / 2) / (blk->kc * fsz), blk->mr);
+  blk->nc = round_down((info->l3  / 2) / (blk->kc * fsz), blk->nr);
+
+  /* Do not let a huge L3 produce absurd panels */
+  if (blk->nc > 8192) blk->nc = 8192;
+}
+
+bool tune_load(const char* path, const cache_info_t* info, blocking_t* blk)
+{
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) return false;
+
+  blocking_t   b = { 0, 0, 0, 0, 0 };
+  cache_info_t c = { 0, 0, 0 };
+
+  char line[256];
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    char          key[64];
+    unsigned long value;
+
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%63[^=]=%lu", key, &value) != 2) continue;
+
+    if      (strcmp(key, "l1d") == 0) c.l1d = value;
+    else if (strcmp(key, "l2" ) == 0) c.l2  = value;
+    else if (strcmp(key, "l3" ) == 0) c.l3  = value;
+    else if (strcmp(key, "mc" ) == 0) b.mc  = value;
+    else if (strcmp(key, "kc" ) == 0) b.kc  = value;
+    else if (strcmp(key, "nc" ) == 0) b.nc  = value;
+    else if (strcmp(key, "mr" ) == 0) b.mr  = value;
+    else if (strcmp(key, "nr" ) == 0) b.nr  = value;
+  }
+  fclose(fp);
+
+  /* A file tuned for a different cache hierarchy is stale */
+  if (c.l1d != info->l1d || c.l2 != info->l2 || c.l3 != info->l3) {
+    return false;
+  }
+
+  if (b.mc == 0 || b.kc == 0 || b.nc == 0 || b.mr == 0 || b.nr == 0) {
+    return false;
+  }
+
+  mmult_opt_blocking(&b);
+  *blk = b;
+
+  return true;
+}
+
+bool tune_save(const char* path, const cache_info_t* info,
+               const blocking_t* blk)
+{
+  FILE* fp = fopen(path, "w");
+  if (fp == NULL) return false;
+
+  fprintf(fp, "# mmult blocking parameters, written by --tune\n");
+  fprintf(fp, "l1d=%zu\n", info->l1d);
+  fprintf(fp, "l2=%zu\n" , info->l2 );
+  fprintf(fp, "l3=%zu\n" , info->l3 );
+  fprintf(fp, "mc=%zu\n" , blk->mc  );
+  fprintf(fp, "kc=%zu\n" , blk->kc  );
+  fprintf(fp, "nc=%zu\n" , blk->nc  );
+  fprintf(fp, "mr=%zu\n" , blk->mr  );
+  fprintf(fp, "nr=%zu\n" , blk->nr  );
+  fclose(fp);
+
+  return true;
+}
+
+/* Best-of-TUNE_REPS runtime of the opt kernel with blocking 'blk' */
+static uint64_t time_blocking(const blocking_t* blk,
+                              size_t m, size_t n, size_t k,
+                              const float* A, const float* B, float* C)
+{
+  /* Packing buffers are allocated outside the timed region */
+  float* work = __ALLOC_DATA(float, mmult_opt_workspace(blk));
+
+  struct timespec ts;
+  struct timespec te;
+  uint64_t best = UINT64_MAX;
+
+  for (int r = 0; r < TUNE_REPS; r++) {
+    memset(C, 0, m * n * sizeof(float));
+
+    __SET_START_TIME();
+    mmult_opt_kernel(m, n, k, A, k, B, n, C, n, blk, work);
+    __SET_END_TIME();
+
+    uint64_t t = __CALC_RUNTIME();
+    if (t < best) best = t;
+  }
+
+  free(work);
+
+  return best;
+}
+
+/* Time every candidate and keep the fastest in 'best' */
+static void try_candidates(blocking_t* best, uint64_t* best_t,
+                           const blocking_t* cands, int ncands,
+                           size_t m, size_t n, size_t k,
+                           const float* A, const float* B, float* C)
+{
+  for (int i = 0; i < ncands; i++) {
+    blocking_t b = cands[i];
+    mmult_opt_blocking(&b);
+
+    uint64_t t = time_blocking(&b, m, n, k, A, B, C);
+    printf("      -> mc=%4zu kc=%4zu nc=%5zu mr=%2zu nr=%2zu : %" PRIu64 " ns\n",
+           b.mc, b.kc, b.nc, b.mr, b.nr, t);
+
+    if (t < *best_t) {
+      *best_t = t;
+      *best    = b;
+    }
+  }
+}
+
+void tune_search(const cache_info_t* info, blocking_t* blk,
+                 size_t m, size_t n, size_t k)
+{
+  /* Keep the search short */
+  m = m < TUNE_MAX_DIM ? m : TUNE_MAX_DIM;
+  n = n < TUNE_MAX_DIM ? n : TUNE_MAX_DIM;
+  k = k < TUNE_MAX_DIM ? k : TUNE_MAX_DIM;
+
+  float* A = __ALLOC_DATA(float, m * k);
+  float* B = __ALLOC_DATA(float, k * n);
+  float* C = __ALLOC_DATA(float, m * n);
+
+  for (size_t i = 0; i < m * k; i++) A[i] = (float)(rand() % 256) / 256.0f;
+  for (size_t i = 0; i < k * n; i++) B[i] = (float)(rand() % 256) / 256.0f;
+
+  /* Starting point */
+  blocking_t best;
+  tune_model_blocking(info, &best);
+  mmult_opt_blocking(&best);
+
+  /* Warm up the caches and page tables before timing anything */
+  time_blocking(&best, m, n, k, A, B, C);
+
+  uint64_t best_t = time_blocking(&best, m, n, k, A, B, C);
+  printf("    + Cache model:\n");
+  printf("      -> mc=%4zu kc=%4zu nc=%5zu mr=%2zu nr=%2zu : %" PRIu64 " ns\n",
+         best.mc, best.kc, best.nc, best.mr, best.nr, best_t);
+
+  blocking_t cands[8];
+  int        ncands;
+
+  /*   -> Register tile, among those the micro-kernel is specialized for */
+  printf("    + Searching mr x nr:\n");
+  ncands = 0;
+  for (int i = 0; i < OPT_NUM_TILES; i++) {
+    cands[ncands] = best;
+    cands[ncands].mr = mmult_opt_tiles[i][0];
+    cands[ncands].nr = mmult_opt_tiles[i][1];
+    ncands++;
+  }
+  try_candidates(&best, &best_t, cands, ncands, m, n, k, A, B, C);
+
+  /*   -> kc, mc, nc around the current best */
+  static const size_t scales[][2] = { {1, 4}, {1, 2}, {2, 1}, {4, 1} };
+
+  printf("    + Searching kc:\n");
+  ncands = 0;
+  for (int i = 0; i < 4; i++) {
+    cands[ncands] = best;
+    cands[ncands].kc = round_down(best.kc * scales[i][0] / scales[i][1], 8);
+    ncands++;
+  }
+  try_candidates(&best, &best_t, cands, ncands, m, n, k, A, B, C);
+
+  printf("    + Searching mc:\n");
+  ncands = 0;
+  for (int i = 0; i < 4; i++) {
+    cands[ncands] = best;
+    cands[ncands].mc = round_down(best.mc * scales[i][0] / scales[i][1],
+                                  best.mr);
+    ncands++;
+  }
+  try_candidates(&best, &best_t, cands, ncands, m, n, k, A, B, C);
+
+  printf("    + Searching nc:\n");
+  ncands = 0;
+  for (int i = 0; i < 4; i++) {
+    cands[ncands] = best;
+    cands[ncands].nc = round_down(best.nc * scales[i][0] / scales[i][1],
+                                  best.nr);
+    /* Panels wider than the problem all behave the same */
+    if (cands[ncands].nc >= n && best.nc >= n) continue;
+    ncands++;
+  }
+  try_candidates(&best, &best_t, cands, ncands, m, n, k, A, B, C);
+
+  *blk = best;
+
+  free(A);
+  free(B);
+  free(C);
+}
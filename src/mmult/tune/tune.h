@@ -0,0 +1,37 @@
+/* tune.h
+ *
+ * Author: Khaleel Alhaboub
+ * Date  : 17 Oct. 2026
+ *
+ * Header for the blocking auto-tuner of the blocked (opt) kernel.
+ */
+
+#ifndef __TUNE_TUNE_H_
+#define __TUNE_TUNE_H_
+
+/* Standard C includes */
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Data cache sizes of the host, in bytes */
+typedef struct {
+  size_t l1d;
+  size_t l2;
+  size_t l3;
+} cache_info_t;
+
+/* Function declarations */
+void tune_cache_info     (cache_info_t* info);
+void tune_default_path   (char* path, size_t len);
+void tune_model_blocking (const cache_info_t* info, blocking_t* blk);
+bool tune_load           (const char* path, const cache_info_t* info,
+                          blocking_t* blk);
+bool tune_save           (const char* path, const cache_info_t* info,
+                          const blocking_t* blk);
+void tune_search         (const cache_info_t* info, blocking_t* blk,
+                          size_t m, size_t n, size_t k);
+
+#endif //__TUNE_TUNE_H_